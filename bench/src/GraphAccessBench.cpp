@@ -0,0 +1,205 @@
+#include "Graph.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+/**
+ * Weights of a complete directed graph, row-major without padding
+ */
+auto makeWeights(size_t order) -> std::vector<int32_t>
+{
+    auto weights = std::vector<int32_t>(order * order);
+
+    auto state = uint32_t {12345};
+    for (auto& weight : weights)
+    {
+        // Linear congruential generator, the weights only have to vary
+        state = state * 1664525 + 1013904223;
+        weight = static_cast<int32_t>(state >> 18);
+    }
+
+    return weights;
+}
+
+template<typename F>
+auto bestOf(size_t repetitions, F&& run) -> std::pair<double, int64_t>
+{
+    auto best = std::chrono::duration<double>::max();
+    auto checksum = int64_t {};
+
+    for (auto i = size_t {}; i < repetitions; i++)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        checksum = run();
+        best = std::min<std::chrono::duration<double>>(best, std::chrono::steady_clock::now() - start);
+    }
+
+    return {best.count(), checksum};
+}
+
+/**
+ * Sums the weights of random edges, the vertices come from a xorshift generator inlined in the loop
+ */
+template<typename Lookup>
+auto sumRandom(size_t order, size_t accesses, const Lookup& lookup) -> int64_t
+{
+    auto state = uint64_t {88172645463325252};
+    auto sum = int64_t {};
+
+    for (auto i = size_t {}; i < accesses; i++)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        const auto from = static_cast<size_t>((state >> 32) * order >> 32);
+        const auto to = static_cast<size_t>((state & 0xFFFFFFFF) * order >> 32);
+        sum += lookup(from, to);
+    }
+
+    return sum;
+}
+
+/**
+ * Sums every weight row by row as many times as it takes to read about the given number of weights
+ */
+template<typename Lookup>
+auto sumRows(size_t order, size_t accesses, const Lookup& lookup) -> int64_t
+{
+    auto sum = int64_t {};
+
+    for (auto pass = size_t {}; pass < std::max<size_t>(accesses / (order * order), 1); pass++)
+    {
+        for (auto from = size_t {}; from < order; from++)
+        {
+            for (auto to = size_t {}; to < order; to++)
+            {
+                sum += lookup(from, to);
+            }
+        }
+    }
+
+    return sum;
+}
+
+/**
+ * Same as sumRows, but every row is looked up once and read as a span
+ */
+template<typename RowOf>
+auto sumRowSpans(size_t order, size_t accesses, const RowOf& rowOf) -> int64_t
+{
+    auto sum = int64_t {};
+
+    for (auto pass = size_t {}; pass < std::max<size_t>(accesses / (order * order), 1); pass++)
+    {
+        for (auto from = size_t {}; from < order; from++)
+        {
+            for (const auto weight : rowOf(from))
+            {
+                sum += weight;
+            }
+        }
+    }
+
+    return sum;
+}
+
+auto report(std::string_view name, std::pair<double, int64_t> result, size_t accesses) -> void
+{
+    const auto& [seconds, checksum] = result;
+    std::cout << "  " << name << ": " << seconds * 1e9 / static_cast<double>(accesses) << " ns per weight"
+              << " (checksum " << checksum << ")\n";
+}
+
+template<typename Lookup>
+auto benchmark(std::string_view name, size_t order, size_t accesses, size_t repetitions, const Lookup& lookup) -> void
+{
+    const auto rowAccesses = std::max<size_t>(accesses / (order * order), 1) * order * order;
+
+    report(std::string {name} + " random", bestOf(repetitions, [&] {
+        return sumRandom(order, accesses, lookup);
+    }), accesses);
+
+    report(std::string {name} + " row-sequential", bestOf(repetitions, [&] {
+        return sumRows(order, accesses, lookup);
+    }), rowAccesses);
+}
+
+}
+
+/**
+ * Compares the weight lookups of dense graphs with the layouts Graph used to have: a vector of row vectors
+ * and one row-major vector without padding. Graphs of 1000 vertices fit in the cache, those of 4000 do not.
+ *
+ * Usage: TSP_READER_GRAPH_BENCH [million accesses = 20] [repetitions = 3] [orders = 1000 4000]
+ */
+auto main(int argc, char** argv) -> int
+{
+    const auto accesses = (argc > 1 ? std::max<size_t>(std::strtoull(argv[1], nullptr, 10), 1) : 20) * 1000000;
+    const auto repetitions = argc > 2 ? std::max<size_t>(std::strtoull(argv[2], nullptr, 10), 1) : 3;
+
+    auto orders = std::vector<size_t> {};
+    for (auto i = 3; i < argc; i++)
+    {
+        orders.push_back(std::max<size_t>(std::strtoull(argv[i], nullptr, 10), 2));
+    }
+    if (orders.empty())
+    {
+        orders = {1000, 4000};
+    }
+
+    std::cout << accesses << " accesses, best of " << repetitions << '\n';
+
+    for (const auto order : orders)
+    {
+        const auto flat = makeWeights(order);
+
+        auto rows = std::vector<std::vector<int32_t>>(order);
+        for (auto vertex = size_t {}; vertex < order; vertex++)
+        {
+            const auto row = flat.begin() + static_cast<std::ptrdiff_t>(vertex * order);
+            rows[vertex].assign(row, row + static_cast<std::ptrdiff_t>(order));
+        }
+
+        auto buffer = tsplib::Graph::WeightBuffer {};
+        buffer.reserve(order * tsplib::Graph::paddedStride(order));
+        buffer.assign(flat.begin(), flat.end());
+        const auto graph = tsplib::Graph::fromWeights(std::move(buffer), order).value();
+
+        // The weights have 14 bits, so the same ones fit 16 bit weights
+        const auto narrowGraph = tsplib::convertGraph<int16_t>(graph).value();
+
+        std::cout << order << " vertices\n";
+
+        benchmark("row vectors", order, accesses, repetitions, [&rows](size_t from, size_t to) {
+            return rows[from][to];
+        });
+        benchmark("flat", order, accesses, repetitions, [&flat, order](size_t from, size_t to) {
+            return flat[from * order + to];
+        });
+        benchmark("Graph", order, accesses, repetitions, [&graph](size_t from, size_t to) {
+            return graph.getWeightUnchecked({from, to});
+        });
+        benchmark("Graph<int16_t>", order, accesses, repetitions, [&narrowGraph](size_t from, size_t to) {
+            return narrowGraph.getWeightUnchecked({from, to});
+        });
+
+        // getWeightUnchecked branches on the representation, reading whole rows lets the compiler vectorize
+        const auto rowAccesses = std::max<size_t>(accesses / (order * order), 1) * order * order;
+        report("Graph getRow row-sequential", bestOf(repetitions, [&graph, order, accesses] {
+            return sumRowSpans(order, accesses, [&graph](size_t from) { return graph.getRow(from); });
+        }), rowAccesses);
+        report("Graph<int16_t> getRow row-sequential", bestOf(repetitions, [&narrowGraph, order, accesses] {
+            return sumRowSpans(order, accesses, [&narrowGraph](size_t from) { return narrowGraph.getRow(from); });
+        }), rowAccesses);
+    }
+
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include "parsers/NumberScanner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace
+{
+
+auto makeSection(size_t bytes) -> std::string
+{
+    auto section = std::string {};
+    section.reserve(bytes + 16);
+
+    auto state = uint32_t {12345};
+    auto column = 0;
+
+    while (section.size() < bytes)
+    {
+        // Linear congruential generator, the weights only have to vary
+        state = state * 1664525 + 1013904223;
+        section += std::to_string(state >> 15 & 0xFFFF);
+        section += ++column % 100 == 0 ? '\n' : ' ';
+    }
+
+    section += "EOF\n";
+    return section;
+}
+
+template<typename F>
+auto bestOf(size_t repetitions, F&& run) -> std::pair<double, size_t>
+{
+    auto best = std::chrono::duration<double>::max();
+    auto count = size_t {};
+
+    for (auto i = size_t {}; i < repetitions; i++)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        count = run();
+        best = std::min<std::chrono::duration<double>>(best, std::chrono::steady_clock::now() - start);
+    }
+
+    return {best.count(), count};
+}
+
+auto report(std::string_view name, std::pair<double, size_t> result, size_t bytes) -> void
+{
+    const auto& [seconds, count] = result;
+    std::cout << name << ": " << seconds << " s, " << static_cast<double>(bytes) / seconds / (1 << 20) << " MiB/s, "
+              << count << " integers\n";
+}
+
+}
+
+/**
+ * Compares the integer scanner with fp::some(fp::tokenLeft(fp::integer<int32_t>)) on a generated
+ * EDGE_WEIGHT_SECTION, a matrix of 5 digit weights 100 to a line.
+ *
+ * Usage: TSP_READER_BENCH [megabytes = 256] [repetitions = 3] [threads = hardware concurrency] [combinator = 1]
+ * A combinator of 0 leaves it out, it takes minutes and many times the input in memory on several gigabytes.
+ */
+auto main(int argc, char** argv) -> int
+{
+    const auto megabytes = argc > 1 ? std::max<size_t>(std::strtoull(argv[1], nullptr, 10), 1) : 256;
+    const auto repetitions = argc > 2 ? std::max<size_t>(std::strtoull(argv[2], nullptr, 10), 1) : 3;
+    const auto threads = argc > 3 ? static_cast<uint32_t>(std::strtoul(argv[3], nullptr, 10))
+                                  : std::max(std::thread::hardware_concurrency(), 1u);
+    const auto withCombinator = argc > 4 ? std::strtoul(argv[4], nullptr, 10) != 0 : true;
+
+    const auto section = makeSection(size_t {megabytes} << 20);
+    std::cout << "Section of " << section.size() << " bytes, best of " << repetitions << '\n';
+
+    report("scanner", bestOf(repetitions, [&section] {
+        return tsplib::integers(section).value().first.size();
+    }), section.size());
+
+    report("scanner on " + std::to_string(threads) + " threads", bestOf(repetitions, [&section, threads] {
+        return tsplib::integers(section, threads).value().first.size();
+    }), section.size());
+
+    if (withCombinator)
+    {
+        report("combinator", bestOf(repetitions, [&section] {
+            return fp::some(fp::tokenLeft(fp::integer<int32_t>))(section).value().first.size();
+        }), section.size());
+    }
+
+    return 0;
+}
@@ -4,6 +4,8 @@
 
 #include <optional>
 #include <string>
+#include <variant>
+#include <vector>
 
 namespace tsplib
 {
@@ -23,12 +25,82 @@ struct MetaData
     std::optional<std::string> name;
     std::optional<std::string> comment;
     std::optional<Type> type;
+    std::optional<size_t> dimension;
 };
 
-struct Content
+/**
+ * Position of a node as given in NODE_COORD_SECTION
+ */
+struct Point2d
+{
+    uint32_t id;
+    double x;
+    double y;
+};
+
+struct Point3d
+{
+    uint32_t id;
+    double x;
+    double y;
+    double z;
+};
+
+using Coordinates = std::variant<std::vector<Point2d>, std::vector<Point3d>>;
+
+struct Section
+{
+    std::string tag;
+    size_t offset;
+};
+
+/**
+ * Specification part of an instance together with the positions of its data sections
+ */
+struct Header
 {
     MetaData metaData;
-    Graph graph;
+    /**
+     * Keyword as written in the instance, e.g. EUC_2D
+     */
+    std::optional<std::string> edgeWeightType;
+    /**
+     * Byte offsets of the section tags, in the order of appearance
+     */
+    std::vector<Section> sections;
 };
 
+template<GraphWeight W>
+struct BasicContent
+{
+    MetaData metaData;
+    BasicGraph<W> graph;
+    std::optional<Coordinates> coordinates;
+};
+
+/**
+ * What the parsers produce, the weights are read as 32 bit integers
+ */
+using Content = BasicContent<Graph::Weight>;
+
+/**
+ * Returns nothing if a weight does not fit the type, see convertGraph
+ */
+template<GraphWeight W>
+[[nodiscard]]
+auto convertContent(BasicContent<Graph::Weight> content) -> std::optional<BasicContent<W>>
+{
+    auto graph = convertGraph<W>(content.graph);
+    if (!graph)
+    {
+        return {};
+    }
+
+    return BasicContent<W> {
+        .metaData = std::move(content.metaData),
+        .graph = std::move(graph).value(),
+        .coordinates = std::move(content.coordinates)
+    };
+}
+
 }
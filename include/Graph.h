@@ -1,29 +1,120 @@
 #pragma once
 
+#include "utils/AlignedAllocator.h"
+
 #include <optional>
 #include <vector>
 #include <cstdint>
 #include <istream>
+#include <ostream>
+#include <algorithm>
+#include <concepts>
 #include <functional>
 #include <limits>
+#include <span>
+#include <type_traits>
 
 namespace tsplib
 {
 
-class Graph
+/**
+ * Rows and columns of the matrix rendered by Graph::render, anything beyond the graph is left out
+ */
+struct RenderWindow
+{
+    size_t firstRow = 0;
+    size_t firstColumn = 0;
+    size_t rows = std::numeric_limits<size_t>::max();
+    size_t columns = std::numeric_limits<size_t>::max();
+
+    /**
+     * Top-left corner of the matrix
+     */
+    [[nodiscard]]
+    static auto preview(size_t vertices) -> RenderWindow
+    {
+        return {.rows = vertices, .columns = vertices};
+    }
+};
+
+/**
+ * How the weights of a graph are stored
+ */
+enum class GraphRepresentation
+{
+    DENSE_MATRIX,
+    /**
+     * Compressed sparse rows, only the existing edges are stored
+     */
+    SPARSE_ROWS,
+    /**
+     * Lower triangle without the diagonal, packed row after row. Every weight stands for both directions,
+     * so adding, removing or setting an edge changes its reverse too.
+     */
+    PACKED_SYMMETRIC
+};
+
+template<typename W>
+concept GraphWeight = std::same_as<W, int16_t> || std::same_as<W, int32_t> || std::same_as<W, float>;
+
+/**
+ * Callback of the forEach* templates, one returning bool stops the iteration by returning false
+ */
+template<typename F, typename Argument>
+concept GraphVisitor = std::invocable<F&, Argument> &&
+                       (std::is_void_v<std::invoke_result_t<F&, Argument>> ||
+                        std::convertible_to<std::invoke_result_t<F&, Argument>, bool>);
+
+namespace detail
+{
+
+template<typename Argument, GraphVisitor<Argument> F>
+auto continueVisiting(F& visitor, Argument&& argument) -> bool
+{
+    if constexpr (std::is_void_v<std::invoke_result_t<F&, Argument>>)
+    {
+        std::invoke(visitor, std::forward<Argument>(argument));
+        return true;
+    }
+    else
+    {
+        return static_cast<bool>(std::invoke(visitor, std::forward<Argument>(argument)));
+    }
+}
+
+}
+
+template<GraphWeight W>
+class BasicGraph;
+
+template<GraphWeight To, GraphWeight From>
+auto convertGraph(const BasicGraph<From>& graph) -> std::optional<BasicGraph<To>>;
+
+/**
+ * Weighted directed graph. It is compiled for the weight types allowed by GraphWeight,
+ * Graph with 32 bit integers is what the parsers produce.
+ */
+template<GraphWeight W>
+class BasicGraph
 {
 public:
     struct Neighbour;
     struct EdgeData;
 
     using Vertex = size_t;
-    using Weight = int32_t;
+    using Weight = W;
     using Edge = std::pair<Vertex, Vertex>;
+    /**
+     * Cache line aligned, so a whole matrix can be handed to a graph without copying it
+     */
+    using WeightBuffer = utils::AlignedVector<Weight>;
 
     using VertexPredicate = std::function<void(Vertex)>;
     using NeighbourPredicate = std::function<void(Neighbour)>;
     using EdgePredicate = std::function<void(const EdgeData&)>;
 
+    using Representation = GraphRepresentation;
+
     struct Neighbour
     {
         Vertex vertex;
@@ -41,14 +132,57 @@ public:
         auto operator!=(const EdgeData& rhs) const noexcept -> bool;
     };
 
-    static constexpr Weight INFINITY_WEIGHT = std::numeric_limits<Weight>::max();
+    /**
+     * Marks a missing edge, so it is not a valid weight. The largest value of integers, infinity of floats.
+     */
+    static constexpr Weight INFINITY_WEIGHT = std::numeric_limits<Weight>::has_infinity
+                                              ? std::numeric_limits<Weight>::infinity()
+                                              : std::numeric_limits<Weight>::max();
 
-    Graph() = default;
-    explicit Graph(size_t order);
+    BasicGraph() = default;
+    explicit BasicGraph(size_t order);
+
+    /**
+     * Adopts a row-major order x order matrix without copying it, INFINITY_WEIGHT marks a missing edge.
+     * The rows are spread to the padded stride in place, which needs no reallocation
+     * if the buffer has room for order * paddedStride(order) weights.
+     * The diagonal is overwritten with INFINITY_WEIGHT since loops are not allowed.
+     * If packing is asked for and the matrix is symmetric, it is packed in place into a lower triangle instead,
+     * which halves its memory.
+     */
+    [[nodiscard]]
+    static auto fromWeights(WeightBuffer weights, size_t order, bool packIfSymmetric = false) -> std::optional<BasicGraph>;
+
+    /**
+     * Adopts the lower triangle without the diagonal listed row by row, i.e. order * (order - 1) / 2 weights
+     */
+    [[nodiscard]]
+    static auto fromSymmetricWeights(WeightBuffer lowerTriangle, size_t order) -> std::optional<BasicGraph>;
+
+    /**
+     * Builds a sparse graph, which takes memory proportional to the order plus the size.
+     * Loops, edges of vertices beyond the order and edges weighing INFINITY_WEIGHT are left out,
+     * of repeated edges only the first one is kept.
+     */
+    [[nodiscard]]
+    static auto fromEdges(std::vector<EdgeData> edges, size_t order) -> BasicGraph;
+
+    /**
+     * Distance between the starts of two consecutive rows, every row starts on a cache line
+     */
+    [[nodiscard]]
+    static constexpr auto paddedStride(size_t order) -> size_t
+    {
+        constexpr auto weightsPerLine = utils::CACHE_LINE_SIZE / sizeof(Weight);
+        return (order + weightsPerLine - 1) / weightsPerLine * weightsPerLine;
+    }
 
     auto addVertex() -> Vertex;
     auto setOrder(size_t order) -> void;
 
+    /**
+     * Adding and removing edges of a sparse graph moves all the edges stored after them
+     */
     auto addEdge(const EdgeData& edge) -> bool;
     auto removeEdge(Edge edge) -> bool;
 
@@ -66,12 +200,42 @@ public:
     [[nodiscard]]
     auto getDensity() const -> double;
     [[nodiscard]]
+    auto getRepresentation() const -> Representation;
+    [[nodiscard]]
     auto getNumberOfNeighboursOf(Vertex vertex) const -> size_t;
 
     [[nodiscard]]
     auto getWeight(Edge edge) const -> std::optional<Weight>;
+    /**
+     * Defined inline, solvers call it in their innermost loops
+     */
     [[nodiscard]]
-    auto getWeightUnchecked(Edge edge) const -> Weight;
+    auto getWeightUnchecked(Edge edge) const -> Weight
+    {
+        if (representation == Representation::DENSE_MATRIX) [[likely]]
+        {
+            return weights[edge.first * stride + edge.second];
+        }
+
+        if (representation == Representation::PACKED_SYMMETRIC)
+        {
+            return edge.first != edge.second ? weights[packedIndex(edge)] : INFINITY_WEIGHT;
+        }
+
+        return getSparseWeight(edge);
+    }
+    /**
+     * Weights of the edges leaving the vertex, INFINITY_WEIGHT marks a missing edge.
+     * Empty unless the graph is a dense matrix.
+     */
+    [[nodiscard]]
+    auto getRow(Vertex vertex) const -> std::span<const Weight>;
+    /**
+     * Same as above for every representation. Rows which are not stored as they are
+     * get written to the buffer, which has to hold getOrder() weights.
+     */
+    [[nodiscard]]
+    auto getRow(Vertex vertex, std::span<Weight> buffer) const -> std::span<const Weight>;
     auto setWeight(Edge edge, Weight weight) -> bool;
 
     [[nodiscard]]
@@ -90,21 +254,271 @@ public:
     auto forEachVertex(const VertexPredicate& predicate) const -> void;
     auto forEachEdge(const EdgePredicate& predicate) const -> void;
 
+    /**
+     * Same as above with the visitor inlined. Returns false if the visitor stopped the iteration.
+     */
+    template<GraphVisitor<Neighbour> Visitor>
+    auto forEachNeighbourOf(Vertex vertex, Visitor&& visitor) const -> bool;
+    template<GraphVisitor<Vertex> Visitor>
+    auto forEachVertex(Visitor&& visitor) const -> bool;
+    template<GraphVisitor<const EdgeData&> Visitor>
+    auto forEachEdge(Visitor&& visitor) const -> bool;
+
+    /**
+     * Writes the weights as a table to the stream row by row, without building the whole text first
+     */
+    auto render(std::ostream& output, const RenderWindow& window = {}) const -> void;
     [[nodiscard]]
     auto toString() const -> std::string;
 
 private:
+    template<GraphWeight To, GraphWeight From>
+    friend auto convertGraph(const BasicGraph<From>& graph) -> std::optional<BasicGraph<To>>;
+
+    /**
+     * Position of an edge of two different vertices in the packed lower triangle
+     */
     [[nodiscard]]
-    auto getColumnWidth() const -> size_t;
+    static constexpr auto packedIndex(Edge edge) -> size_t
+    {
+        const auto row = std::max(edge.first, edge.second);
+        const auto column = std::min(edge.first, edge.second);
+
+        return row * (row - 1) / 2 + column;
+    }
+
     [[nodiscard]]
-    static auto rowSeparator(size_t columns, size_t columnWidth) -> std::string;
+    auto at(Vertex from, Vertex to) -> Weight&;
     [[nodiscard]]
-    static auto closingSeparator(size_t columns, size_t columnWidth) -> std::string;
+    auto at(Vertex from, Vertex to) const -> Weight;
     [[nodiscard]]
-    static auto openingSeparator(size_t columns, size_t columnWidth) -> std::string;
+    auto row(Vertex vertex) const -> std::span<const Weight>;
 
-    std::vector<std::vector<Weight>> graph;
+    /**
+     * Slot of the edge even if it weighs INFINITY_WEIGHT, nothing if a sparse graph has no slot for it
+     */
+    [[nodiscard]]
+    auto find(Edge edge) const -> const Weight*;
+    [[nodiscard]]
+    auto find(Edge edge) -> Weight*;
+    [[nodiscard]]
+    auto getSparseWeight(Edge edge) const -> Weight;
+    [[nodiscard]]
+    auto sparseColumns(Vertex vertex) const -> std::span<const Vertex>;
+    [[nodiscard]]
+    auto sparseWeights(Vertex vertex) const -> std::span<const Weight>;
+    auto insertSparseEdge(const EdgeData& edge) -> void;
+    /**
+     * Expands a packed graph into a matrix, since an edge is about to differ from its reverse
+     */
+    auto unpack() -> void;
+
+    Representation representation = Representation::DENSE_MATRIX;
+    /**
+     * Dense matrix: row-major with a stride of at least paddedStride(order), the padding holds INFINITY_WEIGHT.
+     * Sparse rows: weights of the edges in the order of columns.
+     * Packed symmetric: row i holds the weights of the edges to the vertices before i.
+     */
+    WeightBuffer weights;
+    /**
+     * Sparse rows only: the edges of a vertex are between its offset and the next one, sorted by column
+     */
+    std::vector<size_t> rowOffsets;
+    std::vector<Vertex> columnIndices;
+    /**
+     * Dense matrix only: rows grow in place into their padding until the order reaches the stride
+     */
+    size_t stride = 0;
+    size_t order = 0;
     size_t size = 0;
 };
 
+template<GraphWeight W>
+template<GraphVisitor<typename BasicGraph<W>::Neighbour> Visitor>
+auto BasicGraph<W>::forEachNeighbourOf(Vertex vertex, Visitor&& visitor) const -> bool
+{
+    if (!doesExist(vertex))
+    {
+        return true;
+    }
+
+    const auto visitNeighbour = [&visitor](Vertex neighbour, Weight weight) {
+        return weight == INFINITY_WEIGHT || detail::continueVisiting(visitor, Neighbour {neighbour, weight});
+    };
+
+    switch (representation)
+    {
+    case Representation::DENSE_MATRIX:
+    {
+        const auto rowWeights = row(vertex);
+        for (auto i = Vertex {}; i < rowWeights.size(); i++)
+        {
+            if (!visitNeighbour(i, rowWeights[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    case Representation::SPARSE_ROWS:
+    {
+        const auto rowColumns = sparseColumns(vertex);
+        const auto rowWeights = sparseWeights(vertex);
+        for (auto i = size_t {}; i < rowColumns.size(); i++)
+        {
+            if (!visitNeighbour(rowColumns[i], rowWeights[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    case Representation::PACKED_SYMMETRIC:
+    {
+        // The row is stored up to the diagonal, the rest of it is the column below the diagonal
+        for (auto i = Vertex {}; i < vertex; i++)
+        {
+            if (!visitNeighbour(i, weights[packedIndex({vertex, 0}) + i]))
+            {
+                return false;
+            }
+        }
+        auto index = packedIndex({vertex + 1, vertex});
+        for (auto i = vertex + 1; i < order; index += i, i++)
+        {
+            if (!visitNeighbour(i, weights[index]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    }
+
+    return true;
+}
+
+template<GraphWeight W>
+template<GraphVisitor<typename BasicGraph<W>::Vertex> Visitor>
+auto BasicGraph<W>::forEachVertex(Visitor&& visitor) const -> bool
+{
+    for (auto i = Vertex {}; i < getOrder(); i++)
+    {
+        if (!detail::continueVisiting(visitor, i))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template<GraphWeight W>
+template<GraphVisitor<const typename BasicGraph<W>::EdgeData&> Visitor>
+auto BasicGraph<W>::forEachEdge(Visitor&& visitor) const -> bool
+{
+    for (auto i = Vertex {}; i < getOrder(); i++)
+    {
+        const auto completed = forEachNeighbourOf(i, [i, &visitor](Neighbour neighbour) {
+            return detail::continueVisiting(visitor, EdgeData {{i, neighbour.vertex}, neighbour.weight});
+        });
+
+        if (!completed)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+extern template class BasicGraph<int16_t>;
+extern template class BasicGraph<int32_t>;
+extern template class BasicGraph<float>;
+
+using Graph = BasicGraph<int32_t>;
+
+/**
+ * Copies the graph with another weight type in the same representation. Sparse rows and packed triangles
+ * are converted weight by weight, matrices row by row since their stride depends on the weight type.
+ * INFINITY_WEIGHT is mapped to its counterpart.
+ * Returns nothing if a weight cannot be represented exactly, or would become INFINITY_WEIGHT.
+ */
+template<GraphWeight To, GraphWeight From>
+[[nodiscard]]
+auto convertGraph(const BasicGraph<From>& graph) -> std::optional<BasicGraph<To>>
+{
+    using Target = BasicGraph<To>;
+
+    const auto convert = [](From weight) -> std::optional<To> {
+        if (weight == BasicGraph<From>::INFINITY_WEIGHT)
+        {
+            return Target::INFINITY_WEIGHT;
+        }
+
+        // Doubles hold every value of the weight types exactly, so they compare the weights before and after
+        if constexpr (std::is_integral_v<To>)
+        {
+            if (!(static_cast<double>(weight) >= std::numeric_limits<To>::min() &&
+                  static_cast<double>(weight) <= std::numeric_limits<To>::max()))
+            {
+                return {};
+            }
+        }
+
+        const auto converted = static_cast<To>(weight);
+        if (static_cast<double>(converted) != static_cast<double>(weight) || converted == Target::INFINITY_WEIGHT)
+        {
+            return {};
+        }
+
+        return converted;
+    };
+
+    auto result = Target {};
+    result.representation = graph.representation;
+    result.rowOffsets = graph.rowOffsets;
+    result.columnIndices = graph.columnIndices;
+    result.order = graph.order;
+    result.size = graph.size;
+
+    if (graph.representation != GraphRepresentation::DENSE_MATRIX)
+    {
+        result.weights.reserve(graph.weights.size());
+
+        for (const auto weight : graph.weights)
+        {
+            const auto converted = convert(weight);
+            if (!converted)
+            {
+                return {};
+            }
+            result.weights.push_back(converted.value());
+        }
+
+        return result;
+    }
+
+    result.stride = Target::paddedStride(graph.order);
+    result.weights.assign(graph.order * result.stride, Target::INFINITY_WEIGHT);
+
+    for (auto vertex = size_t {}; vertex < graph.order; vertex++)
+    {
+        const auto* const source = graph.weights.data() + vertex * graph.stride;
+        auto* const target = result.weights.data() + vertex * result.stride;
+
+        for (auto i = size_t {}; i < graph.order; i++)
+        {
+            const auto converted = convert(source[i]);
+            if (!converted)
+            {
+                return {};
+            }
+            target[i] = converted.value();
+        }
+    }
+
+    return result;
+}
+
 }
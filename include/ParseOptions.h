@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+namespace tsplib
+{
+
+struct ParseStats;
+
+struct ParseOptions
+{
+    /**
+     * Number of threads used to parse large numeric sections, 1 parses everything on the calling thread
+     */
+    uint32_t threads = 1;
+    /**
+     * Receives the statistics of the load if the library is built with TSPLIB_PARSE_STATS.
+     * Loads running at the same time must not share it.
+     */
+    ParseStats* stats = nullptr;
+};
+
+}
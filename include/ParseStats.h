@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Graph.h"
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+namespace tsplib
+{
+
+#ifdef TSPLIB_PARSE_STATS
+inline constexpr auto PARSE_STATS_ENABLED = true;
+#else
+inline constexpr auto PARSE_STATS_ENABLED = false;
+#endif
+
+/**
+ * Where the time and memory of a single load went. Only filled if the library is built with TSPLIB_PARSE_STATS,
+ * otherwise nothing is measured and the statistics are left untouched.
+ */
+struct ParseStats
+{
+    /**
+     * Reading the specification and the numbers of the sections
+     */
+    std::chrono::nanoseconds tokenizing {};
+    /**
+     * TspData::filtered, which turns the parsed items into a configuration
+     */
+    std::chrono::nanoseconds filtering {};
+    /**
+     * Building graphs from edge data, which evaluates the distance function for every edge.
+     * Timed once per graph rather than per edge, it is a part of the graph building.
+     */
+    std::chrono::nanoseconds distances {};
+    std::chrono::nanoseconds graphBuilding {};
+    std::chrono::nanoseconds total {};
+
+    /**
+     * Size of the parsed text, gzip compressed files count decompressed
+     */
+    size_t bytes = 0;
+    /**
+     * Specification items plus the numbers read from the data sections
+     */
+    size_t tokens = 0;
+    /**
+     * Allocations made by the loading thread and by the threads it starts
+     */
+    size_t allocations = 0;
+    /**
+     * Most memory held at once during the load, not counting what was allocated before it started
+     */
+    size_t peakAllocatedBytes = 0;
+
+    std::optional<Graph::Representation> representation;
+};
+
+}
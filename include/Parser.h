@@ -183,11 +183,11 @@ inline constexpr auto item = [](std::string_view input) -> Result<char> {
 
 constexpr Parser auto str(std::string_view match)
 {
-    return [match](std::string_view input) -> Result<std::string> {
+    return [match](std::string_view input) -> Result<std::string_view> {
         if (input.starts_with(match))
         {
             return {{
-                        std::string {match}, {input.begin() + match.size(), input.end()}
+                        input.substr(0, match.size()), input.substr(match.size())
                     }};
         }
         else
@@ -197,6 +197,24 @@ constexpr Parser auto str(std::string_view match)
     };
 }
 
+/**
+ * Returns the slice of the input consumed by the parser instead of its value
+ */
+template<Parser P>
+constexpr Parser auto capture(P parser)
+{
+    return [parser](std::string_view input) -> Result<std::string_view> {
+        if (const auto& result = std::invoke(parser, input))
+        {
+            return {{input.substr(0, input.size() - result->second.size()), result->second}};
+        }
+        else
+        {
+            return {};
+        }
+    };
+}
+
 constexpr Parser auto skip(Parser auto p, Parser auto q)
 {
     return choice(chain(p, [q](const auto&) { return q; }), q);
@@ -230,6 +248,10 @@ constexpr Parser auto symbol(char x)
 
 // Iteration helpers
 
+/**
+ * Folds the results of repeatedly applying a parser in a loop, so neither time nor stack usage
+ * depends on the number of parsed elements. The accumulator is moved into each step.
+ */
 template<typename T, Parser P, std::regular_invocable<T, ParserValue<P>> F>
 requires std::convertible_to<std::invoke_result_t<F, T, ParserValue<P>>, T>
 class ReduceMany
@@ -242,11 +264,21 @@ public:
 
     constexpr auto operator()(std::string_view input) const -> Result<T>
     {
-        return choice(
-            chain(parser, [this](const auto& thing) {
-                return ReduceMany {std::invoke(func, init, thing), parser, func};
-            }), unit(init)
-        )(input);
+        auto accumulated = init;
+
+        while (auto result = std::invoke(parser, input))
+        {
+            // A parser which does not consume anything would match forever
+            if (result->second.size() == input.size())
+            {
+                break;
+            }
+
+            accumulated = std::invoke(func, std::move(accumulated), std::move(result->first));
+            input = result->second;
+        }
+
+        return {{std::move(accumulated), input}};
     }
 
 private:
@@ -256,9 +288,9 @@ private:
 };
 
 template<typename T>
-auto appendedVector(std::vector<T> x, const T& y) -> std::vector<T>
+auto appendedVector(std::vector<T> x, T y) -> std::vector<T>
 {
-    x.push_back(y);
+    x.push_back(std::move(y));
     return x;
 }
 
@@ -269,15 +301,27 @@ auto appendedVector(std::vector<T> x, const std::vector<T>& vec) -> std::vector<
     return x;
 }
 
+/**
+ * Counts the matches of a character parser, nothing is copied
+ */
 template<Parser P>
 requires std::same_as<ParserValue<P>, char>
-constexpr Parser auto many(P parser)
+constexpr Parser auto countMany(P parser)
 {
-    return ReduceMany(std::string {},
+    return ReduceMany(size_t {},
                       parser,
-                      [](const std::string& str, char ch) {
-                          return str + ch;
-                      });
+                      [](size_t count, char) { return count + 1; });
+}
+
+/**
+ * Character runs are returned as views of the input, so the character parser has to consume
+ * exactly the character it returns (as satisfy does)
+ */
+template<Parser P>
+requires std::same_as<ParserValue<P>, char>
+constexpr Parser auto many(P parser)
+{
+    return capture(countMany(parser));
 }
 
 template<Parser P>
@@ -288,7 +332,7 @@ constexpr Parser auto many(P parser)
     return ReduceMany(
         Ts {},
         parser,
-        [](Ts const& ts, T const& t) { return appendedVector(ts, t); }
+        [](Ts ts, T t) { return appendedVector(std::move(ts), std::move(t)); }
     );
 }
 
@@ -296,11 +340,7 @@ template<Parser P>
 requires std::same_as<ParserValue<P>, char>
 constexpr Parser auto some(P parser)
 {
-    return sequence(
-        [](char ch, const std::string& str) { return std::string(1, ch) + str; },
-        parser,
-        many(parser)
-    );
+    return capture(chain(parser, [parser](char) { return countMany(parser); }));
 }
 
 template<Parser P>
@@ -308,11 +348,13 @@ constexpr Parser auto some(P parser)
 {
     using T = ParserValue<P>;
     using Ts = std::vector<T>;
-    return sequence(
-        [](const T& item, const Ts& vec) { return appendedVector(Ts {item}, vec); },
-        parser,
-        many(parser)
-    );
+    return chain(parser, [parser](const T& item) {
+        return ReduceMany(
+            Ts {item},
+            parser,
+            [](Ts ts, T t) { return appendedVector(std::move(ts), std::move(t)); }
+        );
+    });
 }
 
 
@@ -404,15 +446,14 @@ constexpr Parser auto tokenRight(Parser auto parser, P toSkip = whitespaces)
 
 template<std::integral T = int32_t>
 Parser auto natural = flatten(sequence(
-    [](auto const& str) { return tsplib::utils::stringToNumber<T>(str); },
+    [](auto str) { return tsplib::utils::stringToNumber<T>(str); },
     some(digit)
 ));
 
 template<std::integral T = int32_t>
 Parser auto negative = flatten(sequence(
-    [](const auto ch, const auto& str) { return tsplib::utils::stringToNumber<T>(std::string {ch} + str); },
-    symbol('-'),
-    some(digit)
+    [](auto str) { return tsplib::utils::stringToNumber<T>(str); },
+    capture(sequence([](auto, auto) { return 0; }, symbol('-'), some(digit)))
 ));
 
 
@@ -423,29 +464,17 @@ Parser auto integer = choice(
 );
 
 template<std::floating_point T = double>
-Parser auto real = flatten(sequence([](const auto& str) { return tsplib::utils::stringToNumber<T>(str); },
-                                    choice(
-                                        sequence([](auto minus, const auto& x, auto, const auto& y) {
-                                                     return
-                                                         (minus ? std::string {*minus} : std::string {}) +
-                                                         x +
-                                                         '.' +
-                                                         (y ? *y : std::string {});
-                                                 },
-                                                 maybe(symbol('-')),
-                                                 some(digit),
-                                                 symbol('.'),
-                                                 maybe(some(digit))),
-                                        sequence([](auto minus, auto point, const auto& x) {
-                                                     return
-                                                         (minus ? std::string {*minus} : std::string {}) +
-                                                         (point ? std::string {*point} : std::string {}) +
-                                                         x;
-                                                 },
-                                                 maybe(symbol('-')),
-                                                 maybe(symbol('.')),
-                                                 some(digit)
-                                        ))));
+Parser auto real = flatten(sequence([](auto str) { return tsplib::utils::stringToNumber<T>(str); },
+                                    capture(sequence([](auto, auto) { return 0; },
+                                        maybe(symbol('-')),
+                                        choice(
+                                            sequence([](auto, auto, auto) { return 0; },
+                                                     some(digit),
+                                                     symbol('.'),
+                                                     maybe(some(digit))),
+                                            sequence([](auto, auto) { return 0; },
+                                                     maybe(symbol('.')),
+                                                     some(digit)))))));
 
 
 }
\ No newline at end of file
@@ -1,11 +1,190 @@
 #pragma once
 
 #include "Content.h"
+#include "ParseOptions.h"
+
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <variant>
+#include <vector>
 
 namespace tsplib
 {
 
+class TspStreamParser;
+
+/**
+ * Reads only the specification part, data sections are skipped without being parsed.
+ * Returns nothing if a line is neither a specification item nor part of a section.
+ */
+[[nodiscard]]
+auto getTspHeader(std::string_view input) -> std::optional<Header>;
+
+[[nodiscard]]
+auto getTspHeaderFromFile(const std::filesystem::path& path) -> std::optional<Header>;
+
+[[nodiscard]]
+auto getTspContent(std::string_view input, const ParseOptions& options = {}) -> std::optional<Content>;
+
+/**
+ * Parses the file straight from its memory mapping, pipes and other special files are read into memory first.
+ * Gzip compressed files are decompressed chunk by chunk into the stream parser if the library is built with zlib.
+ */
+[[nodiscard]]
+auto getTspContentFromFile(const std::filesystem::path& path, const ParseOptions& options = {}) -> std::optional<Content>;
+
+/**
+ * Parses the files on the given number of threads, the largest ones are started first.
+ * Results are in the order of the paths, a file that cannot be read or parsed has no content.
+ * No statistics are collected.
+ */
+[[nodiscard]]
+auto getTspContents(std::span<const std::filesystem::path> paths,
+                    uint32_t threads,
+                    const ParseOptions& options = {}) -> std::vector<std::optional<Content>>;
+
+/**
+ * Content of any of the weight types the graphs are compiled for
+ */
+using AnyContent = std::variant<BasicContent<int16_t>, BasicContent<int32_t>, BasicContent<float>>;
+
+/**
+ * Moves already parsed content to the narrowest integer weight type that holds all of its weights,
+ * e.g. 16 bit integers halve the size of the matrix when every weight is below INT16_MAX.
+ * Both graphs are held at once while it runs, getNarrowestTspContent parses into the narrow type instead.
+ */
+[[nodiscard]]
+auto narrowContent(Content content) -> AnyContent;
+
+/**
+ * Scans an EDGE_WEIGHT_SECTION straight into weights of the given type, so the matrix is never held
+ * as 32 bit integers. float reads non-integer weights too. 16 bit weights fail the load unless every weight
+ * off the diagonal is below INFINITY_WEIGHT. Graphs made from edge data are sparse, they are built
+ * with 32 bit weights and converted, see convertGraph.
+ */
+template<GraphWeight W>
+[[nodiscard]]
+auto getTspContentAs(std::string_view input, const ParseOptions& options = {}) -> std::optional<BasicContent<W>>;
+
+/**
+ * Parses the instance with 16 bit weights, and with 32 bit ones only if a weight does not fit.
+ * The statistics then cover both loads. Non-integer weights are read only by getTspContentAs<float>.
+ */
+[[nodiscard]]
+auto getNarrowestTspContent(std::string_view input, const ParseOptions& options = {}) -> std::optional<AnyContent>;
+
+/**
+ * Instance read from a binary cache. The weights are not deserialized, they are read straight from the file mapping.
+ * Copies share the mapping.
+ */
+class CachedContent
+{
+public:
+    /**
+     * Returns nothing if the file is not a cache of the current format version
+     */
+    [[nodiscard]]
+    static auto open(const std::filesystem::path& path) -> std::optional<CachedContent>;
+
+    [[nodiscard]]
+    auto getMetaData() const -> const MetaData&;
+    [[nodiscard]]
+    auto getCoordinates() const -> const std::optional<Coordinates>&;
+    [[nodiscard]]
+    auto getOrder() const -> size_t;
+    [[nodiscard]]
+    auto getSize() const -> size_t;
+    /**
+     * The representation the graph had when it was cached, which decides how the weights are laid out
+     */
+    [[nodiscard]]
+    auto getRepresentation() const -> GraphRepresentation;
+    /**
+     * A row-major order x order matrix, the lower triangle without the diagonal row by row,
+     * or the weights of the sparse rows one row after another. INFINITY_WEIGHT marks a missing edge.
+     */
+    [[nodiscard]]
+    auto getWeights() const -> std::span<const Graph::Weight>;
+    /**
+     * Column of each weight of sparse rows, empty for the other representations
+     */
+    [[nodiscard]]
+    auto getColumnIndices() const -> std::span<const Graph::Vertex>;
+    /**
+     * The weights of a sparse row run from its offset to the next one, empty for the other representations
+     */
+    [[nodiscard]]
+    auto getRowOffsets() const -> std::span<const size_t>;
+    /**
+     * Hash of the instance the cache was made from
+     */
+    [[nodiscard]]
+    auto getSourceHash() const -> uint64_t;
+
+    /**
+     * Copies the weights into a graph that can be modified
+     */
+    [[nodiscard]]
+    auto toContent() const -> Content;
+
+private:
+    CachedContent() = default;
+
+    std::shared_ptr<const void> storage;
+    MetaData metaData;
+    std::optional<Coordinates> coordinates;
+    GraphRepresentation representation = GraphRepresentation::DENSE_MATRIX;
+    std::span<const Graph::Weight> weights;
+    std::span<const Graph::Vertex> columnIndices;
+    std::span<const size_t> rowOffsets;
+    size_t order = 0;
+    size_t size = 0;
+    uint64_t sourceHash = 0;
+};
+
+/**
+ * Writes the content in the binary format read by CachedContent, the file is replaced atomically
+ */
+auto writeTspCache(const Content& content, uint64_t sourceHash, const std::filesystem::path& path) -> bool;
+
+/**
+ * Loads the instance from its cache, which is kept next to the file as <file>.tspcache and rebuilt when the hash
+ * of the file changes. If that directory is not writable the cache goes to $XDG_CACHE_HOME/tsplib or
+ * ~/.cache/tsplib, which must be a directory only the user can access.
+ */
 [[nodiscard]]
-auto getTspContent([[maybe_unused]] std::string_view input) -> std::optional<Content>;
+auto getTspContentCached(const std::filesystem::path& path, const ParseOptions& options = {})
+    -> std::optional<CachedContent>;
+
+/**
+ * Parses an instance pushed in chunks of any size, e.g. read from a pipe.
+ * Only not yet parsed input is kept, in a buffer of fixed size.
+ * Large sections are parsed on the threads of the options a buffer at a time.
+ */
+class StreamReader
+{
+public:
+    explicit StreamReader(size_t bufferSize = size_t {1} << 16, const ParseOptions& options = {});
+    StreamReader(StreamReader&& other) noexcept;
+    ~StreamReader();
+
+    auto operator=(StreamReader&& other) noexcept -> StreamReader&;
+
+    /**
+     * Returns false if the input cannot be parsed, e.g. a single line does not fit in the buffer
+     */
+    auto feed(std::span<const char> chunk) -> bool;
+
+    /**
+     * Parses the rest of the buffered input. No more chunks can be fed afterwards.
+     */
+    [[nodiscard]]
+    auto finish() -> std::optional<Content>;
+
+private:
+    std::unique_ptr<TspStreamParser> parser;
+    ParseStats* stats = nullptr;
+};
 
 }
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Content.h"
+
+#include <filesystem>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace tsplib
+{
+
+/**
+ * Layout of EDGE_WEIGHT_SECTION, every format except FULL_MATRIX needs a symmetric graph
+ */
+enum class MatrixFormat
+{
+    FULL_MATRIX,
+    UPPER_ROW,
+    LOWER_ROW,
+    UPPER_DIAG_ROW,
+    LOWER_DIAG_ROW,
+    UPPER_COL,
+    LOWER_COL,
+    UPPER_DIAG_COL,
+    LOWER_DIAG_COL
+};
+
+struct WriteOptions
+{
+    MatrixFormat format = MatrixFormat::FULL_MATRIX;
+};
+
+/**
+ * Writes the content as an instance with explicit weights, the coordinates go to NODE_COORD_SECTION.
+ * Missing edges are written as INFINITY_WEIGHT and the diagonal as 0.
+ * Returns false if the format does not fit the graph or the stream fails.
+ */
+auto writeTspContent(std::ostream& output, const Content& content, const WriteOptions& options = {}) -> bool;
+
+auto writeTspContentToFile(const std::filesystem::path& path, const Content& content, const WriteOptions& options = {})
+    -> bool;
+
+[[nodiscard]]
+auto tspContentToString(const Content& content, const WriteOptions& options = {}) -> std::optional<std::string>;
+
+/**
+ * Writes a TOUR instance, the vertices are numbered from 1 as in TOUR_SECTION
+ */
+auto writeTspTour(std::ostream& output, std::span<const Graph::Vertex> tour, std::string_view name = {}) -> bool;
+
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace tsplib::utils
+{
+
+inline constexpr auto CACHE_LINE_SIZE = size_t {64};
+
+/**
+ * Allocates every block at the start of a cache line, so rows and SIMD loads never straddle two of them
+ */
+template<typename T, size_t Alignment = CACHE_LINE_SIZE>
+struct AlignedAllocator
+{
+    static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0);
+
+    using value_type = T;
+
+    template<typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept
+    {
+
+    }
+
+    [[nodiscard]]
+    auto allocate(size_t count) -> T*
+    {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t {Alignment}));
+    }
+
+    auto deallocate(T* memory, size_t count) noexcept -> void
+    {
+        ::operator delete(memory, count * sizeof(T), std::align_val_t {Alignment});
+    }
+
+    template<typename U>
+    auto operator==(const AlignedAllocator<U, Alignment>&) const noexcept -> bool
+    {
+        return true;
+    }
+};
+
+template<typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+}
@@ -1,11 +1,16 @@
 #pragma once
 
-#include <stdexcept>
+#include <algorithm>
 #include <charconv>
 #include <optional>
+#include <string>
+#include <string_view>
 #include <sstream>
 #include <iomanip>
 #include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
 
 namespace tsplib::utils
 {
@@ -25,7 +30,7 @@ constexpr auto maxLengthOfType() -> uint32_t
 
 template<std::integral T>
 [[nodiscard]]
-auto stringToNumber(const std::string& number) -> std::optional<T>
+auto stringToNumber(std::string_view number) -> std::optional<T>
 {
     T result;
     const auto [ptr, code] {std::from_chars(number.data(), number.data() + number.size(), result)};
@@ -38,58 +43,176 @@ auto stringToNumber(const std::string& number) -> std::optional<T>
     return result;
 }
 
+namespace detail
+{
+
+inline constexpr auto exactPowersOfTen = std::array<double, 23> {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
 /**
- * GCC and clang does not support std::from_chars for floating point types (although it is standardized)
+ * Clinger's fast path: if the decimal significand fits into 53 bits and the power of ten is exact,
+ * a single multiplication or division is correctly rounded. Returns nothing for every other input.
  */
-#if defined(_MSC_VER)
-
-template<std::floating_point T>
 [[nodiscard]]
-auto stringToNumber(const std::string& number) -> std::optional<T>
+constexpr auto fastStringToDouble(std::string_view number) -> std::optional<double>
 {
-    T result;
-    auto const[ptr, code] {std::from_chars(number.data(), number.data() + number.size(), result)};
+    constexpr auto maxExactSignificand = uint64_t {1} << 53;
+    constexpr auto maxDigits = 19;
+    constexpr auto maxExponent = 22;
 
-    if (code == std::errc::invalid_argument || code == std::errc::result_out_of_range)
+    const auto isDigit = [](char symbol) { return symbol >= '0' && symbol <= '9'; };
+
+    auto position = size_t {};
+    const auto isNegative = number.starts_with('-');
+    position += isNegative ? 1 : 0;
+
+    auto significand = uint64_t {};
+    auto digitsCount = 0;
+    auto exponent = 0;
+    auto hasDigits = false;
+
+    const auto readDigits = [&](bool isFraction) {
+        while (position < number.size() && isDigit(number[position]))
+        {
+            hasDigits = true;
+            if (significand != 0 || number[position] != '0')
+            {
+                digitsCount++;
+            }
+            significand = significand * 10 + static_cast<uint64_t>(number[position] - '0');
+            exponent -= isFraction ? 1 : 0;
+            position++;
+
+            if (digitsCount > maxDigits)
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    if (!readDigits(false))
     {
         return {};
     }
 
-    return result;
-}
+    if (position < number.size() && number[position] == '.')
+    {
+        position++;
+        if (!readDigits(true))
+        {
+            return {};
+        }
+    }
 
-#else
+    if (!hasDigits)
+    {
+        return {};
+    }
 
-template<std::floating_point T>
-[[nodiscard]]
-auto stringToNumber(const std::string& number) -> std::optional<T>
-{
-    try
+    if (position < number.size() && (number[position] == 'e' || number[position] == 'E'))
     {
-        if constexpr (std::same_as<T, float>)
+        auto exponentPosition = position + 1;
+        const auto isExponentNegative = exponentPosition < number.size() && number[exponentPosition] == '-';
+        if (exponentPosition < number.size() && (number[exponentPosition] == '-' || number[exponentPosition] == '+'))
         {
-            return std::stof(number);
+            exponentPosition++;
         }
-        else if constexpr (std::same_as<T, double>)
+
+        auto explicitExponent = 0;
+        const auto digitsStart = exponentPosition;
+        while (exponentPosition < number.size() && isDigit(number[exponentPosition]) && explicitExponent < 1000)
         {
-            return std::stod(number);
+            explicitExponent = explicitExponent * 10 + (number[exponentPosition] - '0');
+            exponentPosition++;
         }
-        else
+
+        if (exponentPosition != digitsStart)
         {
-            return std::stold(number);
+            exponent += isExponentNegative ? -explicitExponent : explicitExponent;
         }
     }
-    catch (const std::out_of_range&)
+
+    if (significand > maxExactSignificand || exponent < -maxExponent || exponent > maxExponent)
     {
         return {};
     }
-    catch (const std::invalid_argument&)
+
+    auto value = static_cast<double>(significand);
+    value = exponent < 0
+            ? value / exactPowersOfTen[static_cast<size_t>(-exponent)]
+            : value * exactPowersOfTen[static_cast<size_t>(exponent)];
+
+    return isNegative ? -value : value;
+}
+
+/**
+ * Correctly rounded conversion by the C library, without exceptions
+ */
+template<std::floating_point T>
+[[nodiscard]]
+auto strtoNumber(std::string_view number) -> std::optional<T>
+{
+    const auto terminated = std::string {number};
+    char* end = nullptr;
+    auto result = T {};
+
+    errno = 0;
+    if constexpr (std::same_as<T, float>)
+    {
+        result = std::strtof(terminated.c_str(), &end);
+    }
+    else if constexpr (std::same_as<T, double>)
+    {
+        result = std::strtod(terminated.c_str(), &end);
+    }
+    else
+    {
+        result = std::strtold(terminated.c_str(), &end);
+    }
+
+    if (end == terminated.c_str() || errno == ERANGE)
     {
         return {};
     }
+
+    return result;
+}
+
 }
 
+/**
+ * Uses std::from_chars where the standard library implements it for floating point types.
+ * Elsewhere doubles take Clinger's fast path and everything else the C library.
+ */
+template<std::floating_point T>
+[[nodiscard]]
+auto stringToNumber(std::string_view number) -> std::optional<T>
+{
+#if defined(__cpp_lib_to_chars)
+    T result;
+    const auto [ptr, code] {std::from_chars(number.data(), number.data() + number.size(), result)};
+
+    if (code == std::errc::invalid_argument || code == std::errc::result_out_of_range)
+    {
+        return {};
+    }
+
+    return result;
+#else
+    if constexpr (std::same_as<T, double>)
+    {
+        if (const auto result = detail::fastStringToDouble(number))
+        {
+            return result;
+        }
+    }
+
+    return detail::strtoNumber<T>(number);
 #endif
+}
 
 template<std::integral T>
 [[nodiscard]]
@@ -103,19 +226,39 @@ auto numberToString(T number) -> std::string
     return result;
 }
 
+/**
+ * Shortest representation which reads back as the same number
+ */
 template<std::floating_point T>
 [[nodiscard]]
 auto numberToString(T number) -> std::string
 {
+#if defined(__cpp_lib_to_chars)
+    static constexpr auto size = maxLengthOfType<T>();
+    auto buffer = std::array<char, size>{};
+    const auto end = std::to_chars(buffer.data(), buffer.data() + size, number).ptr;
+    return {buffer.data(), end};
+#else
     auto stream = std::stringstream {};
-    stream << number;
+    stream << std::setprecision(std::numeric_limits<T>::max_digits10) << number;
     return stream.str();
+#endif
 }
 
 template<std::floating_point T>
 [[nodiscard]]
 auto numberToString(T number, int32_t precision) -> std::string
 {
+#if defined(__cpp_lib_to_chars)
+    // Fixed notation of the largest values takes all the digits of the exponent
+    auto buffer = std::array<char, maxLengthOfType<T>() + 1>{};
+    const auto [end, code] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), number,
+                                           std::chars_format::fixed, precision);
+    if (code == std::errc {})
+    {
+        return {buffer.data(), end};
+    }
+#endif
     auto stream = std::stringstream {};
     stream << std::fixed << std::setprecision(precision) << number;
     return stream.str();
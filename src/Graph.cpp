@@ -1,53 +1,410 @@
 #include "Graph.h"
-#include "utils/utils.h"
+#include "io/BufferedWriter.h"
+#include "utils/Simd.h"
+#include "utils/Utils.h"
 
 #include <algorithm>
+#include <array>
+#include <charconv>
+#include <concepts>
 #include <numeric>
+#include <sstream>
+#include <utility>
+
+#ifdef TSPLIB_AVX2_DISPATCH
+#include <immintrin.h>
+#endif
 
 namespace tsplib
 {
 
-Graph::Graph(size_t order)
-    : graph(order, std::vector<Weight>(order, Graph::INFINITY_WEIGHT))
+namespace
 {
 
+auto triangleSize(size_t order) -> size_t
+{
+    return order * (order - std::min<size_t>(order, 1)) / 2;
 }
 
-bool Graph::EdgeData::operator==(const EdgeData& rhs) const noexcept
+/**
+ * Checks the rows from the given one on against their columns
+ */
+template<typename W>
+auto isSymmetricScalar(const W* weights, size_t order, size_t firstRow) -> bool
 {
-    return vertices == rhs.vertices && weight == rhs.weight;
+    for (auto i = firstRow; i < order; i++)
+    {
+        for (auto j = size_t {}; j < i; j++)
+        {
+            if (weights[i * order + j] != weights[j * order + i])
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
 }
 
-bool Graph::EdgeData::operator!=(const EdgeData& rhs) const noexcept
+#ifdef TSPLIB_AVX2_DISPATCH
+
+/**
+ * Loads 8 consecutive weights as 32 bit lanes, 16 bit integers are sign extended
+ */
+template<typename W>
+__attribute__((target("avx2")))
+auto loadEight(const W* weights) -> __m256i
 {
-    return !(*this == rhs);
+    if constexpr (sizeof(W) == sizeof(int16_t))
+    {
+        return _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(weights)));
+    }
+    else
+    {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights));
+    }
+}
+
+__attribute__((target("avx2")))
+auto transposeEightByEight(__m256i (&rows)[8]) -> void
+{
+    const auto t0 = _mm256_unpacklo_epi32(rows[0], rows[1]);
+    const auto t1 = _mm256_unpackhi_epi32(rows[0], rows[1]);
+    const auto t2 = _mm256_unpacklo_epi32(rows[2], rows[3]);
+    const auto t3 = _mm256_unpackhi_epi32(rows[2], rows[3]);
+    const auto t4 = _mm256_unpacklo_epi32(rows[4], rows[5]);
+    const auto t5 = _mm256_unpackhi_epi32(rows[4], rows[5]);
+    const auto t6 = _mm256_unpacklo_epi32(rows[6], rows[7]);
+    const auto t7 = _mm256_unpackhi_epi32(rows[6], rows[7]);
+
+    const auto u0 = _mm256_unpacklo_epi64(t0, t2);
+    const auto u1 = _mm256_unpackhi_epi64(t0, t2);
+    const auto u2 = _mm256_unpacklo_epi64(t1, t3);
+    const auto u3 = _mm256_unpackhi_epi64(t1, t3);
+    const auto u4 = _mm256_unpacklo_epi64(t4, t6);
+    const auto u5 = _mm256_unpackhi_epi64(t4, t6);
+    const auto u6 = _mm256_unpacklo_epi64(t5, t7);
+    const auto u7 = _mm256_unpackhi_epi64(t5, t7);
+
+    rows[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+    rows[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+    rows[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+    rows[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+    rows[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+    rows[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+    rows[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+    rows[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+/**
+ * One bit for each of the 8 lanes, floats compare as numbers like the scalar check does
+ */
+template<typename W>
+__attribute__((target("avx2")))
+auto equalLanes(__m256i lhs, __m256i rhs) -> uint32_t
+{
+    if constexpr (std::floating_point<W>)
+    {
+        const auto equal = _mm256_cmp_ps(_mm256_castsi256_ps(lhs), _mm256_castsi256_ps(rhs), _CMP_EQ_OQ);
+        return static_cast<uint32_t>(_mm256_movemask_ps(equal));
+    }
+    else
+    {
+        return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(lhs, rhs))));
+    }
+}
+
+/**
+ * Compares the 8 x 8 blocks on and below the diagonal with the transposed blocks above it,
+ * the rows which do not fill a block are left to the scalar check
+ */
+template<typename W>
+__attribute__((target("avx2")))
+auto isSymmetricAvx2(const W* weights, size_t order) -> bool
+{
+    static constexpr auto blockSize = size_t {8};
+    static constexpr auto allLanes = uint32_t {0xFF};
+
+    const auto blockedOrder = order / blockSize * blockSize;
+
+    for (auto blockRow = size_t {}; blockRow < blockedOrder; blockRow += blockSize)
+    {
+        for (auto blockColumn = size_t {}; blockColumn <= blockRow; blockColumn += blockSize)
+        {
+            // std::array would drop the alignment attribute of the vector type
+            __m256i mirrored[blockSize];
+            for (auto i = size_t {}; i < blockSize; i++)
+            {
+                mirrored[i] = loadEight(weights + (blockColumn + i) * order + blockRow);
+            }
+            transposeEightByEight(mirrored);
+
+            auto equal = allLanes;
+            for (auto i = size_t {}; i < blockSize; i++)
+            {
+                equal &= equalLanes<W>(loadEight(weights + (blockRow + i) * order + blockColumn), mirrored[i]);
+            }
+
+            if (equal != allLanes)
+            {
+                return false;
+            }
+        }
+    }
+
+    return isSymmetricScalar(weights, order, blockedOrder);
+}
+
+#endif
+
+/**
+ * The matrix is row-major without padding
+ */
+template<typename W>
+auto isSymmetric(const W* weights, size_t order) -> bool
+{
+#ifdef TSPLIB_AVX2_DISPATCH
+    if (utils::isAvx2Supported())
+    {
+        return isSymmetricAvx2(weights, order);
+    }
+#endif
+    return isSymmetricScalar(weights, order, 0);
+}
+
+/**
+ * Rows of the lower triangle only move backward, so going from the first one never overwrites a row that is
+ * still to be moved. The memory of the upper triangle is given back.
+ */
+template<typename Buffer>
+auto packLowerTriangle(Buffer& weights, size_t order) -> void
+{
+    auto packedEnd = weights.begin();
+
+    for (auto row = size_t {1}; row < order; row++)
+    {
+        packedEnd = std::copy_n(weights.begin() + static_cast<std::ptrdiff_t>(row * order), row, packedEnd);
+    }
+
+    weights.resize(triangleSize(order));
+    weights.shrink_to_fit();
+}
+
+}
+
+template<GraphWeight W>
+BasicGraph<W>::BasicGraph(size_t order)
+    : weights(order * paddedStride(order), INFINITY_WEIGHT)
+    , stride(paddedStride(order))
+    , order(order)
+{
+
+}
+
+template<GraphWeight W>
+auto BasicGraph<W>::fromWeights(WeightBuffer weights, size_t order, bool packIfSymmetric) -> std::optional<BasicGraph>
+{
+    if (weights.size() != order * order)
+    {
+        return {};
+    }
+
+    for (auto i = Vertex {}; i < order; i++)
+    {
+        weights[i * order + i] = INFINITY_WEIGHT;
+    }
+
+    if (packIfSymmetric && isSymmetric(weights.data(), order))
+    {
+        packLowerTriangle(weights, order);
+        return fromSymmetricWeights(std::move(weights), order);
+    }
+
+    const auto stride = paddedStride(order);
+    weights.resize(order * stride, INFINITY_WEIGHT);
+
+    // Rows only move forward, so going from the last one never overwrites a row that is still to be moved
+    for (auto i = order; i-- > 1;)
+    {
+        const auto source = weights.begin() + static_cast<std::ptrdiff_t>(i * order);
+        const auto target = weights.begin() + static_cast<std::ptrdiff_t>(i * stride);
+        std::copy_backward(source, source + static_cast<std::ptrdiff_t>(order), target + static_cast<std::ptrdiff_t>(order));
+        std::fill(source, std::min(target, source + static_cast<std::ptrdiff_t>(order)), INFINITY_WEIGHT);
+    }
+
+    auto result = BasicGraph {};
+    result.weights = std::move(weights);
+    result.stride = stride;
+    result.order = order;
+    result.size = static_cast<size_t>(std::ranges::count_if(result.weights, [](auto weight) {
+        return weight != INFINITY_WEIGHT;
+    }));
+
+    return result;
+}
+
+template<GraphWeight W>
+auto BasicGraph<W>::fromSymmetricWeights(WeightBuffer lowerTriangle, size_t order) -> std::optional<BasicGraph>
+{
+    if (lowerTriangle.size() != triangleSize(order))
+    {
+        return {};
+    }
+
+    auto result = BasicGraph {};
+    result.representation = Representation::PACKED_SYMMETRIC;
+    result.weights = std::move(lowerTriangle);
+    result.order = order;
+    result.size = 2 * static_cast<size_t>(std::ranges::count_if(result.weights, [](auto weight) {
+        return weight != INFINITY_WEIGHT;
+    }));
+
+    return result;
 }
 
-auto Graph::addVertex() -> Vertex
+template<GraphWeight W>
+auto BasicGraph<W>::fromEdges(std::vector<EdgeData> edges, size_t order) -> BasicGraph
 {
-    for (auto& row : graph)
+    std::erase_if(edges, [order](const EdgeData& edge) {
+        const auto [from, to] = edge.vertices;
+        return from == to || from >= order || to >= order || edge.weight == INFINITY_WEIGHT;
+    });
+
+    std::ranges::stable_sort(edges, {}, &EdgeData::vertices);
+    const auto repeated = std::ranges::unique(edges, {}, &EdgeData::vertices);
+    edges.erase(repeated.begin(), repeated.end());
+
+    auto result = BasicGraph {};
+    result.representation = Representation::SPARSE_ROWS;
+    result.order = order;
+    result.size = edges.size();
+    result.rowOffsets.assign(order + 1, 0);
+    result.columnIndices.reserve(edges.size());
+    result.weights.reserve(edges.size());
+
+    for (const auto& edge : edges)
     {
-        row.push_back(Graph::INFINITY_WEIGHT);
+        result.rowOffsets[edge.vertices.first + 1]++;
+        result.columnIndices.push_back(edge.vertices.second);
+        result.weights.push_back(edge.weight);
     }
 
+    std::partial_sum(result.rowOffsets.begin(), result.rowOffsets.end(), result.rowOffsets.begin());
+
+    return result;
+}
+
+template<GraphWeight W>
+bool BasicGraph<W>::EdgeData::operator==(const EdgeData& rhs) const noexcept
+{
+    return vertices == rhs.vertices && weight == rhs.weight;
+}
+
+template<GraphWeight W>
+bool BasicGraph<W>::EdgeData::operator!=(const EdgeData& rhs) const noexcept
+{
+    return !(*this == rhs);
+}
+
+template<GraphWeight W>
+auto BasicGraph<W>::addVertex() -> Vertex
+{
     const auto newVertex = getOrder() - 1;
 
-    graph.emplace_back(getOrder() + 1, Graph::INFINITY_WEIGHT);
+    setOrder(getOrder() + 1);
 
     return newVertex;
 }
 
-auto Graph::setOrder(size_t order) -> void
+template<GraphWeight W>
+auto BasicGraph<W>::setOrder(size_t newOrder) -> void
 {
-    for (auto& row : graph)
+    if (representation == Representation::SPARSE_ROWS)
+    {
+        if (newOrder < order)
+        {
+            // Shrinking drops the edges of the removed vertices
+            auto keptEdges = std::vector<EdgeData> {};
+            forEachEdge([&keptEdges, newOrder](const EdgeData& edge) {
+                if (edge.vertices.first < newOrder && edge.vertices.second < newOrder)
+                {
+                    keptEdges.push_back(edge);
+                }
+            });
+
+            *this = fromEdges(std::move(keptEdges), newOrder);
+        }
+        else
+        {
+            rowOffsets.resize(newOrder + 1, rowOffsets.back());
+            order = newOrder;
+        }
+
+        return;
+    }
+
+    if (representation == Representation::PACKED_SYMMETRIC)
+    {
+        // Rows of the triangle do not depend on the order, so vertices are added and removed at its end
+        weights.resize(triangleSize(newOrder), INFINITY_WEIGHT);
+
+        if (newOrder < order)
+        {
+            size = 2 * static_cast<size_t>(std::ranges::count_if(weights, [](auto weight) {
+                return weight != INFINITY_WEIGHT;
+            }));
+        }
+
+        order = newOrder;
+        return;
+    }
+
+    // Growing by an eighth keeps adding vertices one by one amortized linear in the size of the matrix,
+    // while a matrix sized exactly for its order gets only a bounded slack
+    const auto grown = [](size_t count) { return count + std::max<size_t>(count / 8, 1); };
+
+    if (newOrder <= stride)
+    {
+        // New rows are appended and new columns are already there as padding
+        if (newOrder * stride > weights.capacity())
+        {
+            weights.reserve(std::min(grown(newOrder), stride) * stride);
+        }
+        weights.resize(newOrder * stride, INFINITY_WEIGHT);
+
+        // Shrinking drops the edges of the removed vertices, their columns become padding again
+        if (newOrder < order)
+        {
+            for (auto i = Vertex {}; i < newOrder; i++)
+            {
+                const auto rowStart = weights.begin() + static_cast<std::ptrdiff_t>(i * stride);
+                std::fill(rowStart + static_cast<std::ptrdiff_t>(newOrder), rowStart + static_cast<std::ptrdiff_t>(order), INFINITY_WEIGHT);
+            }
+
+            size = static_cast<size_t>(std::ranges::count_if(weights, [](auto weight) { return weight != INFINITY_WEIGHT; }));
+        }
+
+        order = newOrder;
+        return;
+    }
+
+    const auto newStride = paddedStride(std::max(newOrder, grown(stride)));
+    auto resized = WeightBuffer {};
+    resized.reserve(std::min(grown(newOrder), newStride) * newStride);
+    resized.resize(newOrder * newStride, INFINITY_WEIGHT);
+
+    for (auto i = Vertex {}; i < order; i++)
     {
-        row.resize(order, Graph::INFINITY_WEIGHT);
+        std::ranges::copy(row(i), resized.begin() + static_cast<std::ptrdiff_t>(i * newStride));
     }
 
-    graph.resize(order, std::vector<Weight>(order, Graph::INFINITY_WEIGHT));
+    weights = std::move(resized);
+    stride = newStride;
+    order = newOrder;
 }
 
-auto Graph::addEdge(const EdgeData& edge) -> bool
+template<GraphWeight W>
+auto BasicGraph<W>::addEdge(const EdgeData& edge) -> bool
 {
     if (edge.vertices.first == edge.vertices.second)
     {
@@ -64,93 +421,197 @@ auto Graph::addEdge(const EdgeData& edge) -> bool
         return false;
     }
 
-    graph[edge.vertices.first][edge.vertices.second] = edge.weight;
+    if (representation == Representation::PACKED_SYMMETRIC)
+    {
+        unpack();
+    }
+
+    if (auto* const weight = find(edge.vertices))
+    {
+        *weight = edge.weight;
+    }
+    else
+    {
+        insertSparseEdge(edge);
+    }
 
     size++;
 
     return true;
 }
 
-auto Graph::removeEdge(Edge edge) -> bool
+template<GraphWeight W>
+auto BasicGraph<W>::removeEdge(Edge edge) -> bool
 {
     if (!doesExist(edge))
     {
         return false;
     }
 
-    graph[edge.first][edge.second] = INFINITY_WEIGHT;
+    if (representation == Representation::PACKED_SYMMETRIC)
+    {
+        unpack();
+    }
+
+    if (representation == Representation::SPARSE_ROWS)
+    {
+        const auto position = find(edge) - weights.data();
+        columnIndices.erase(columnIndices.begin() + position);
+        weights.erase(weights.begin() + position);
+
+        for (auto vertex = edge.first + 1; vertex <= order; vertex++)
+        {
+            rowOffsets[vertex]--;
+        }
+    }
+    else
+    {
+        *find(edge) = INFINITY_WEIGHT;
+    }
 
     size--;
 
     return true;
 }
 
-auto Graph::getWeight(Edge edge) const -> std::optional<Weight>
+template<GraphWeight W>
+auto BasicGraph<W>::getWeight(Edge edge) const -> std::optional<Weight>
 {
     if (!doesExist(edge))
     {
         return {};
     }
-    return graph[edge.first][edge.second];
+    return *find(edge);
+}
+
+template<GraphWeight W>
+auto BasicGraph<W>::getRow(Vertex vertex) const -> std::span<const Weight>
+{
+    if (!doesExist(vertex) || representation != Representation::DENSE_MATRIX)
+    {
+        return {};
+    }
+
+    return row(vertex);
 }
 
-auto Graph::getWeightUnchecked(Graph::Edge edge) const -> Weight
+template<GraphWeight W>
+auto BasicGraph<W>::getRow(Vertex vertex, std::span<Weight> buffer) const -> std::span<const Weight>
 {
-    return graph[edge.first][edge.second];
+    if (representation == Representation::DENSE_MATRIX)
+    {
+        return getRow(vertex);
+    }
+
+    if (!doesExist(vertex) || buffer.size() < getOrder())
+    {
+        return {};
+    }
+
+    const auto result = buffer.first(getOrder());
+
+    if (representation == Representation::PACKED_SYMMETRIC)
+    {
+        // The row is stored up to the diagonal, the rest of it is the column below the diagonal
+        std::ranges::copy(std::span {weights}.subspan(packedIndex({vertex, 0}), vertex), result.begin());
+        result[vertex] = INFINITY_WEIGHT;
+
+        for (auto column = vertex + 1; column < getOrder(); column++)
+        {
+            result[column] = weights[packedIndex({column, vertex})];
+        }
+
+        return result;
+    }
+
+    const auto rowColumns = sparseColumns(vertex);
+    const auto rowWeights = sparseWeights(vertex);
+
+    std::ranges::fill(result, INFINITY_WEIGHT);
+    for (auto i = size_t {}; i < rowColumns.size(); i++)
+    {
+        result[rowColumns[i]] = rowWeights[i];
+    }
+
+    return result;
 }
 
-auto Graph::setWeight(Edge edge, Weight weight) -> bool
+template<GraphWeight W>
+auto BasicGraph<W>::setWeight(Edge edge, Weight weight) -> bool
 {
     if (!doesExist(edge))
     {
         return false;
     }
 
-    graph[edge.first][edge.second] = weight;
+    if (representation == Representation::PACKED_SYMMETRIC && *find(edge) != weight)
+    {
+        unpack();
+    }
+
+    *find(edge) = weight;
 
     return true;
 }
 
-auto Graph::getOrder() const -> size_t
+template<GraphWeight W>
+auto BasicGraph<W>::getOrder() const -> size_t
 {
-    return graph.size();
+    return order;
 }
 
-auto Graph::getSize() const -> size_t
+template<GraphWeight W>
+auto BasicGraph<W>::getSize() const -> size_t
 {
     return size;
 }
 
-auto Graph::getDensity() const -> double
+template<GraphWeight W>
+auto BasicGraph<W>::getDensity() const -> double
 {
     return static_cast<float>(getSize()) / static_cast<float>((getOrder() * (getOrder() - 1)));
 }
 
-auto Graph::getNumberOfNeighboursOf(Vertex vertex) const -> size_t
+template<GraphWeight W>
+auto BasicGraph<W>::getNumberOfNeighboursOf(Vertex vertex) const -> size_t
 {
     if (!doesExist(vertex))
     {
         return 0;
     }
 
-    return std::ranges::count_if(graph[vertex], [](auto weight) { return weight != INFINITY_WEIGHT; });
+    if (representation == Representation::PACKED_SYMMETRIC)
+    {
+        auto count = size_t {};
+        forEachNeighbourOf(vertex, [&count](Neighbour) { count++; });
+        return count;
+    }
+
+    const auto rowWeights = representation == Representation::DENSE_MATRIX ? row(vertex) : sparseWeights(vertex);
+
+    return std::ranges::count_if(rowWeights, [](auto weight) { return weight != INFINITY_WEIGHT; });
 }
 
-auto Graph::doesExist(Vertex vertex) const -> bool
+template<GraphWeight W>
+auto BasicGraph<W>::doesExist(Vertex vertex) const -> bool
 {
     return vertex < getOrder();
 }
 
-auto Graph::doesExist(Edge edge) const -> bool
+template<GraphWeight W>
+auto BasicGraph<W>::doesExist(Edge edge) const -> bool
 {
     if (!doesExist(edge.first) || !doesExist(edge.second))
     {
         return false;
     }
-    return graph[edge.first][edge.second] != INFINITY_WEIGHT;
+
+    const auto* const weight = find(edge);
+    return weight != nullptr && *weight != INFINITY_WEIGHT;
 }
 
-auto Graph::getNeighboursOf(Vertex vertex) const -> std::optional<std::vector<Neighbour>>
+template<GraphWeight W>
+auto BasicGraph<W>::getNeighboursOf(Vertex vertex) const -> std::optional<std::vector<Neighbour>>
 {
     if (!doesExist(vertex))
     {
@@ -160,18 +621,13 @@ auto Graph::getNeighboursOf(Vertex vertex) const -> std::optional<std::vector<Ne
     auto result = std::vector<Neighbour> {};
     result.reserve(getNumberOfNeighboursOf(vertex));
 
-    for (auto i = Vertex {}; i < getOrder(); i++)
-    {
-        if (graph[vertex][i] != INFINITY_WEIGHT)
-        {
-            result.push_back({i, graph[vertex][i]});
-        }
-    }
+    forEachNeighbourOf(vertex, [&result](Neighbour neighbour) { result.push_back(neighbour); });
 
     return result;
 }
 
-auto Graph::getVertices() const -> std::vector<Vertex>
+template<GraphWeight W>
+auto BasicGraph<W>::getVertices() const -> std::vector<Vertex>
 {
     auto result = std::vector<Vertex>(getOrder());
 
@@ -180,253 +636,366 @@ auto Graph::getVertices() const -> std::vector<Vertex>
     return result;
 }
 
-auto Graph::getEdges() const -> std::vector<EdgeData>
+template<GraphWeight W>
+auto BasicGraph<W>::getEdges() const -> std::vector<EdgeData>
 {
     auto result = std::vector<EdgeData> {};
     result.reserve(getSize());
 
-    for (auto i = Vertex {}; i < getOrder(); i++)
-    {
-        for (auto j = Vertex {}; j < getOrder(); j++)
-        {
-            if (graph[i][j] != INFINITY_WEIGHT)
-            {
-                result.push_back({{i, j}, graph[i][j]});
-            }
-        }
-    }
+    forEachEdge([&result](const EdgeData& edge) { result.push_back(edge); });
 
     return result;
 }
 
-auto Graph::forEachNeighbourOf(Vertex vertex, const NeighbourPredicate& predicate) const -> void
+template<GraphWeight W>
+auto BasicGraph<W>::forEachNeighbourOf(Vertex vertex, const NeighbourPredicate& predicate) const -> void
 {
-    if (!doesExist(vertex))
-    {
-        return;
-    }
+    forEachNeighbourOf(vertex, [&predicate](Neighbour neighbour) { predicate(neighbour); });
+}
+
+template<GraphWeight W>
+auto BasicGraph<W>::forEachVertex(const VertexPredicate& predicate) const -> void
+{
+    forEachVertex([&predicate](Vertex vertex) { predicate(vertex); });
+}
+
+template<GraphWeight W>
+auto BasicGraph<W>::forEachEdge(const EdgePredicate& predicate) const -> void
+{
+    forEachEdge([&predicate](const EdgeData& edge) { predicate(edge); });
+}
 
-    for (auto i = Vertex {}; i < getOrder(); i++)
+namespace
+{
+
+using CellBuffer = std::array<char, std::max(utils::maxLengthOfType<uint64_t>(), utils::maxLengthOfType<float>())>;
+
+template<typename T>
+    requires std::integral<T> || std::floating_point<T>
+auto cellText(T number, CellBuffer& buffer) -> std::string_view
+{
+    if constexpr (GraphWeight<T>)
     {
-        if (graph[vertex][i] != INFINITY_WEIGHT)
+        if (number == BasicGraph<T>::INFINITY_WEIGHT)
         {
-            predicate({i, graph[vertex][i]});
+            return "inf";
         }
     }
+
+    const auto end = std::to_chars(buffer.data(), buffer.data() + buffer.size(), number).ptr;
+    return {buffer.data(), static_cast<size_t>(end - buffer.data())};
 }
 
-auto Graph::forEachVertex(const VertexPredicate& predicate) const -> void
+auto writeCentered(BufferedWriter& writer, std::string_view text, size_t width) -> void
 {
-    for (auto i = Vertex {}; i < getOrder(); i++)
+    if (width <= text.size())
     {
-        predicate(i);
+        writer.write(text);
+        return;
     }
-}
 
-auto Graph::forEachEdge(const EdgePredicate& predicate) const -> void
-{
-    for (auto i = Vertex {}; i < getOrder(); i++)
+    const auto halfSpaces = (width - text.size()) / 2;
+
+    for (auto i = size_t {0}; i < halfSpaces; i++)
     {
-        for (auto j = Vertex {}; j < getOrder(); j++)
-        {
-            if (graph[i][j] != Graph::INFINITY_WEIGHT)
-            {
-                predicate({{i, j}, graph[i][j]});
-            }
-        }
+        writer.write(' ');
+    }
+    writer.write(text);
+    for (auto i = halfSpaces + text.size(); i < width; i++)
+    {
+        writer.write(' ');
     }
 }
 
-auto Graph::toString() const -> std::string
+struct SeparatorSymbols
 {
-    std::string result = "\n";
-    const auto columnWidth = getColumnWidth();
-    const auto separator = rowSeparator(getOrder() + 1, columnWidth);
-
-    for (uint32_t i = 0; i <= getOrder(); i++)
+    std::string_view line;
+    std::string_view first;
+    std::string_view middle;
+    std::string_view last;
+};
+
+constexpr auto OPENING_SEPARATOR = SeparatorSymbols {
+    utils::DOUBLE_HORIZONTAL_BAR,
+    utils::DOUBLE_CROSS,
+    utils::DOUBLE_HORIZONTAL_BAR_VERTICAL_BAR,
+    utils::VERTICAL_BAR_DOUBLE_LEFT
+};
+
+constexpr auto ROW_SEPARATOR = SeparatorSymbols {
+    utils::HORIZONTAL_BAR,
+    utils::DOUBLE_VERTICAL_BAR_HORIZONTAL_BAR,
+    utils::CROSS,
+    utils::VERTICAL_BAR_LEFT
+};
+
+constexpr auto CLOSING_SEPARATOR = SeparatorSymbols {
+    utils::HORIZONTAL_BAR,
+    utils::HORIZONTAL_BAR_DOUBLE_UP,
+    utils::HORIZONTAL_BAR_UP,
+    utils::UP_LEFT
+};
+
+auto writeSeparator(BufferedWriter& writer, const SeparatorSymbols& symbols, size_t columns, size_t columnWidth) -> void
+{
+    for (auto i = size_t {0}; i < columns; i++)
     {
-        for (uint32_t j = 0; j <= getOrder(); j++)
+        for (auto j = size_t {0}; j < columnWidth; j++)
         {
-            if (i == 0)
-            {
-                if (j == 0)
-                {
-                    result += std::string(columnWidth, ' ') + utils::DOUBLE_VERTICAL_BAR;
-                }
-                else
-                {
-                    const auto number = utils::numberToString(j - 1);
-                    result += utils::putInStringCenter(number, columnWidth) + utils::VERTICAL_BAR;
-                }
-            }
-            else
-            {
-                if (j == 0)
-                {
-                    const auto number = utils::numberToString(i - 1);
-                    result += utils::putInStringCenter(number, columnWidth) + utils::DOUBLE_VERTICAL_BAR;
-                }
-                else
-                {
-                    auto number = std::string{};
-                    if (graph[i - 1][j - 1] == INFINITY_WEIGHT)
-                    {
-                        number = "inf";
-                    }
-                    else
-                    {
-                        number = utils::numberToString(graph[i - 1][j - 1]);
-                    }
-                    result += utils::putInStringCenter(number, columnWidth) + utils::VERTICAL_BAR;
-                }
-            }
+            writer.write(symbols.line);
         }
+
         if (i == 0)
         {
-            result += "\n" + openingSeparator(getOrder() + 1, columnWidth) + "\n";
+            writer.write(symbols.first);
         }
-        else if (i != getOrder())
+        else if (i != columns - 1)
         {
-            result += "\n" + separator + "\n";
+            writer.write(symbols.middle);
         }
         else
         {
-            result += "\n" + closingSeparator(getOrder() + 1, columnWidth);
+            writer.write(symbols.last);
         }
     }
-    return result;
 }
 
-auto Graph::getColumnWidth() const -> size_t
+}
+
+template<GraphWeight W>
+auto BasicGraph<W>::render(std::ostream& output, const RenderWindow& window) const -> void
 {
-    auto columnWidth = size_t{};
-    for (uint32_t i = 0; i <= getOrder(); i++)
+    const auto firstRow = std::min(window.firstRow, getOrder());
+    const auto firstColumn = std::min(window.firstColumn, getOrder());
+    const auto rows = std::min(window.rows, getOrder() - firstRow);
+    const auto columns = std::min(window.columns, getOrder() - firstColumn);
+
+    auto buffer = CellBuffer {};
+    auto rowBuffer = std::vector<Weight>(getOrder());
+
+    // Labels grow with the vertex, the last one is the widest
+    auto columnWidth = cellText(std::max(firstRow + rows, firstColumn + columns) - 1, buffer).size();
+
+    if constexpr (std::floating_point<Weight>)
     {
-        if (i == 0)
+        // The length of a fraction does not grow with its magnitude, so every weight is measured
+        for (auto vertex = firstRow; vertex < firstRow + rows; vertex++)
         {
-            const auto length = utils::numberToString(getOrder() - 1).length();
-            if (length > columnWidth)
+            for (const auto weight : getRow(vertex, rowBuffer).subspan(firstColumn, columns))
             {
-                columnWidth = length;
+                columnWidth = std::max(columnWidth, cellText(weight, buffer).size());
             }
         }
-        else
+    }
+    else
+    {
+        // Numbers are the longest at the extremes, so the width is known without formatting every weight
+        auto minWeight = Weight {0};
+        auto maxWeight = Weight {0};
+        auto hasInfinity = false;
+
+        for (auto vertex = firstRow; vertex < firstRow + rows; vertex++)
         {
-            for (uint32_t j = 0; j <= getOrder(); j++)
+            for (const auto weight : getRow(vertex, rowBuffer).subspan(firstColumn, columns))
             {
-                auto weightLength = size_t{};
-                if (j == 0)
+                if (weight == INFINITY_WEIGHT)
                 {
-                    weightLength = utils::numberToString(i - 1).length();
-                }
-                else if (graph[j - 1][i - 1] == INFINITY_WEIGHT)
-                {
-                    weightLength = 3;
+                    hasInfinity = true;
                 }
                 else
                 {
-                    weightLength = utils::numberToString(graph[j - 1][i - 1]).length();
-                }
-
-                if (weightLength > columnWidth)
-                {
-                    columnWidth = weightLength;
+                    minWeight = std::min(minWeight, weight);
+                    maxWeight = std::max(maxWeight, weight);
                 }
             }
         }
+
+        columnWidth = std::max(columnWidth, cellText(minWeight, buffer).size());
+        columnWidth = std::max(columnWidth, cellText(maxWeight, buffer).size());
+        if (hasInfinity)
+        {
+            columnWidth = std::max(columnWidth, cellText(INFINITY_WEIGHT, buffer).size());
+        }
     }
 
-    return columnWidth;
-}
+    auto writer = BufferedWriter {output, size_t {1} << 16};
 
-auto Graph::rowSeparator(size_t columns, size_t columnWidth) -> std::string
-{
-    auto result = std::string{};
-    for (uint32_t i = 0; i < columns; i++)
+    for (auto i = size_t {0}; i < columnWidth; i++)
     {
-        for (uint32_t j = 0; j < columnWidth; j++)
-        {
-            result += utils::HORIZONTAL_BAR;
-        }
-        if (i == 0)
-        {
-            result += utils::DOUBLE_VERTICAL_BAR_HORIZONTAL_BAR;
-        }
-        else if (i != columns - 1)
+        writer.write(' ');
+    }
+    writer.write(utils::DOUBLE_VERTICAL_BAR);
+
+    for (auto column = firstColumn; column < firstColumn + columns; column++)
+    {
+        writeCentered(writer, cellText(column, buffer), columnWidth);
+        writer.write(utils::VERTICAL_BAR);
+    }
+
+    writer.write('\n');
+    writeSeparator(writer, OPENING_SEPARATOR, columns + 1, columnWidth);
+    writer.write('\n');
+
+    for (auto vertex = firstRow; vertex < firstRow + rows; vertex++)
+    {
+        writeCentered(writer, cellText(vertex, buffer), columnWidth);
+        writer.write(utils::DOUBLE_VERTICAL_BAR);
+
+        for (const auto weight : getRow(vertex, rowBuffer).subspan(firstColumn, columns))
         {
-            result += utils::CROSS;
+            writeCentered(writer, cellText(weight, buffer), columnWidth);
+            writer.write(utils::VERTICAL_BAR);
         }
-        else
+
+        writer.write('\n');
+        writeSeparator(writer, vertex + 1 != firstRow + rows ? ROW_SEPARATOR : CLOSING_SEPARATOR, columns + 1,
+                       columnWidth);
+        if (vertex + 1 != firstRow + rows)
         {
-            result += utils::VERTICAL_BAR_LEFT;
+            writer.write('\n');
         }
     }
-    return result;
 }
 
-auto Graph::closingSeparator(size_t columns, size_t columnWidth) -> std::string
+template<GraphWeight W>
+auto BasicGraph<W>::toString() const -> std::string
+{
+    auto output = std::ostringstream {};
+    output << '\n';
+    render(output);
+    return std::move(output).str();
+}
+
+template<GraphWeight W>
+auto BasicGraph<W>::at(Vertex from, Vertex to) -> Weight&
+{
+    return weights[from * stride + to];
+}
+
+template<GraphWeight W>
+auto BasicGraph<W>::at(Vertex from, Vertex to) const -> Weight
+{
+    return weights[from * stride + to];
+}
+
+template<GraphWeight W>
+auto BasicGraph<W>::row(Vertex vertex) const -> std::span<const Weight>
+{
+    return std::span {weights}.subspan(vertex * stride, order);
+}
+
+template<GraphWeight W>
+auto BasicGraph<W>::find(Edge edge) const -> const Weight*
 {
-    auto result = std::string{};
-    for (uint32_t i = 0; i < columns; i++)
+    if (representation == Representation::DENSE_MATRIX)
     {
-        for (uint32_t j = 0; j < columnWidth; j++)
-        {
-            result += utils::HORIZONTAL_BAR;
-        }
-        if (i == 0)
-        {
-            result += utils::HORIZONTAL_BAR_DOUBLE_UP;
-        }
-        else if (i != columns - 1)
-        {
-            result += utils::HORIZONTAL_BAR_UP;
-        }
-        else
-        {
-            result += utils::UP_LEFT;
-        }
+        return &weights[edge.first * stride + edge.second];
+    }
+
+    if (representation == Representation::PACKED_SYMMETRIC)
+    {
+        return edge.first != edge.second ? &weights[packedIndex(edge)] : nullptr;
+    }
+
+    const auto rowColumns = sparseColumns(edge.first);
+    const auto column = std::ranges::lower_bound(rowColumns, edge.second);
+
+    if (column == rowColumns.end() || *column != edge.second)
+    {
+        return nullptr;
+    }
+
+    return &weights[rowOffsets[edge.first] + static_cast<size_t>(column - rowColumns.begin())];
+}
+
+template<GraphWeight W>
+auto BasicGraph<W>::find(Edge edge) -> Weight*
+{
+    return const_cast<Weight*>(std::as_const(*this).find(edge));
+}
+
+template<GraphWeight W>
+auto BasicGraph<W>::getSparseWeight(Edge edge) const -> Weight
+{
+    const auto* const weight = find(edge);
+    return weight != nullptr ? *weight : INFINITY_WEIGHT;
+}
+
+template<GraphWeight W>
+auto BasicGraph<W>::sparseColumns(Vertex vertex) const -> std::span<const Vertex>
+{
+    return std::span {columnIndices}.subspan(rowOffsets[vertex], rowOffsets[vertex + 1] - rowOffsets[vertex]);
+}
+
+template<GraphWeight W>
+auto BasicGraph<W>::sparseWeights(Vertex vertex) const -> std::span<const Weight>
+{
+    return std::span {weights}.subspan(rowOffsets[vertex], rowOffsets[vertex + 1] - rowOffsets[vertex]);
+}
+
+template<GraphWeight W>
+auto BasicGraph<W>::insertSparseEdge(const EdgeData& edge) -> void
+{
+    const auto [from, to] = edge.vertices;
+    const auto rowColumns = sparseColumns(from);
+    const auto position = static_cast<std::ptrdiff_t>(rowOffsets[from]) +
+                          (std::ranges::lower_bound(rowColumns, to) - rowColumns.begin());
+
+    columnIndices.insert(columnIndices.begin() + position, to);
+    weights.insert(weights.begin() + position, edge.weight);
+
+    for (auto vertex = from + 1; vertex <= order; vertex++)
+    {
+        rowOffsets[vertex]++;
     }
-    return result;
 }
 
-auto Graph::openingSeparator(size_t columns, size_t columnWidth) -> std::string
+template<GraphWeight W>
+auto BasicGraph<W>::unpack() -> void
 {
-    auto result = std::string{};
-    for (uint32_t i = 0; i < columns; i++)
+    stride = paddedStride(order);
+    auto matrix = WeightBuffer(order * stride, INFINITY_WEIGHT);
+
+    for (auto from = Vertex {}; from < order; from++)
     {
-        for (uint32_t j = 0; j < columnWidth; j++)
-        {
-            result += utils::DOUBLE_HORIZONTAL_BAR;
-        }
-        if (i == 0)
-        {
-            result += utils::DOUBLE_CROSS;
-        }
-        else if (i != columns - 1)
-        {
-            result += utils::DOUBLE_HORIZONTAL_BAR_VERTICAL_BAR;
-        }
-        else
+        for (auto to = Vertex {}; to < from; to++)
         {
-            result += utils::VERTICAL_BAR_DOUBLE_LEFT;
+            const auto weight = weights[packedIndex({from, to})];
+            matrix[from * stride + to] = weight;
+            matrix[to * stride + from] = weight;
         }
     }
-    return result;
+
+    representation = Representation::DENSE_MATRIX;
+    weights = std::move(matrix);
 }
 
-auto Graph::isEmpty() const -> bool
+template<GraphWeight W>
+auto BasicGraph<W>::getRepresentation() const -> Representation
+{
+    return representation;
+}
+
+template<GraphWeight W>
+auto BasicGraph<W>::isEmpty() const -> bool
 {
     return getOrder() == 0;
 }
 
-auto Graph::isComplete() const -> bool
+template<GraphWeight W>
+auto BasicGraph<W>::isComplete() const -> bool
 {
     return size == getOrder() * (getOrder() - 1) && !isEmpty() && !isEdgeless();
 }
 
-auto Graph::isEdgeless() const -> bool
+template<GraphWeight W>
+auto BasicGraph<W>::isEdgeless() const -> bool
 {
     return size == 0;
 }
 
+template class BasicGraph<int16_t>;
+template class BasicGraph<int32_t>;
+template class BasicGraph<float>;
+
 }
\ No newline at end of file
@@ -0,0 +1,565 @@
+#include "BinaryCache.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace tsplib
+{
+
+namespace
+{
+
+constexpr auto MAGIC = std::array {'T', 'S', 'P', 'C', 'A', 'C', 'H', 'E'};
+constexpr auto BYTE_ORDER_MARK = uint32_t {0x01020304};
+constexpr auto WEIGHTS_ALIGNMENT = size_t {64};
+
+struct CacheHeader
+{
+    std::array<char, 8> magic;
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t sourceHash;
+    uint64_t order;
+    uint64_t size;
+    uint64_t metaDataSize;
+    uint64_t coordinatesCount;
+    uint32_t coordinatesDimension;
+    uint32_t representation;
+    uint64_t weightsOffset;
+};
+
+static_assert(std::is_trivially_copyable_v<CacheHeader> && sizeof(CacheHeader) == 72);
+// Sparse rows are stored as the graph keeps them, so that they can be used from the mapping
+static_assert(sizeof(Graph::Vertex) == sizeof(uint64_t) && sizeof(size_t) == sizeof(uint64_t));
+
+/**
+ * Offsets of the parts following the header and the metadata
+ */
+struct CacheOffsets
+{
+    size_t ids;
+    size_t values;
+    size_t weights;
+};
+
+auto alignedUp(size_t offset, size_t alignment) -> size_t
+{
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+auto getOffsets(size_t metaDataSize, size_t coordinatesCount, size_t coordinatesDimension) -> CacheOffsets
+{
+    const auto ids = alignedUp(sizeof(CacheHeader) + metaDataSize, alignof(double));
+    const auto values = alignedUp(ids + coordinatesCount * sizeof(uint32_t), alignof(double));
+    const auto weights = alignedUp(values + coordinatesCount * coordinatesDimension * sizeof(double), WEIGHTS_ALIGNMENT);
+
+    return {ids, values, weights};
+}
+
+template<typename T>
+auto appendBytes(std::string& output, const T& value) -> void
+{
+    output.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template<typename T>
+auto appendOptional(std::string& output, const std::optional<T>& value) -> void
+{
+    appendBytes(output, static_cast<uint8_t>(value.has_value()));
+
+    if constexpr (std::is_same_v<T, std::string>)
+    {
+        if (value)
+        {
+            appendBytes(output, static_cast<uint64_t>(value->size()));
+            output += *value;
+        }
+    }
+    else
+    {
+        if (value)
+        {
+            appendBytes(output, static_cast<uint64_t>(*value));
+        }
+    }
+}
+
+auto serializedMetaData(const MetaData& metaData) -> std::string
+{
+    auto result = std::string {};
+    appendOptional(result, metaData.name);
+    appendOptional(result, metaData.comment);
+    appendOptional(result, metaData.type);
+    appendOptional(result, metaData.dimension);
+    return result;
+}
+
+/**
+ * Bounds checked reads from the cache bytes
+ */
+class ByteReader
+{
+public:
+    explicit ByteReader(std::string_view bytes)
+        : bytes {bytes}
+    {
+
+    }
+
+    template<typename T>
+    [[nodiscard]]
+    auto read() -> std::optional<T>
+    {
+        if (bytes.size() < sizeof(T))
+        {
+            return {};
+        }
+
+        auto value = T {};
+        std::memcpy(&value, bytes.data(), sizeof(T));
+        bytes.remove_prefix(sizeof(T));
+        return value;
+    }
+
+    [[nodiscard]]
+    auto readString(size_t size) -> std::optional<std::string>
+    {
+        if (bytes.size() < size)
+        {
+            return {};
+        }
+
+        auto value = std::string {bytes.substr(0, size)};
+        bytes.remove_prefix(size);
+        return value;
+    }
+
+    [[nodiscard]]
+    auto isEmpty() const -> bool
+    {
+        return bytes.empty();
+    }
+
+private:
+    std::string_view bytes;
+};
+
+/**
+ * Reads an optional value serialized by appendOptional, the outer optional is empty if the bytes are malformed
+ */
+template<typename T>
+auto readOptional(ByteReader& reader) -> std::optional<std::optional<T>>
+{
+    const auto hasValue = reader.read<uint8_t>();
+
+    if (!hasValue || *hasValue > 1)
+    {
+        return {};
+    }
+
+    if (*hasValue == 0)
+    {
+        return std::optional<T> {};
+    }
+
+    const auto value = reader.read<uint64_t>();
+
+    if (!value)
+    {
+        return {};
+    }
+
+    if constexpr (std::is_same_v<T, std::string>)
+    {
+        auto string = reader.readString(*value);
+
+        if (!string)
+        {
+            return {};
+        }
+
+        return std::optional<T> {std::move(string)};
+    }
+    else
+    {
+        return std::optional<T> {static_cast<T>(*value)};
+    }
+}
+
+auto readMetaData(std::string_view bytes) -> std::optional<MetaData>
+{
+    auto reader = ByteReader {bytes};
+
+    auto name = readOptional<std::string>(reader);
+    auto comment = readOptional<std::string>(reader);
+    const auto type = readOptional<uint64_t>(reader);
+    const auto dimension = readOptional<size_t>(reader);
+
+    if (!name || !comment || !type || !dimension || !reader.isEmpty())
+    {
+        return {};
+    }
+
+    if (type.value() && *type.value() > static_cast<uint64_t>(Type::TOUR))
+    {
+        return {};
+    }
+
+    return MetaData {
+        .name = std::move(name.value()),
+        .comment = std::move(comment.value()),
+        .type = type.value() ? std::optional {static_cast<Type>(*type.value())} : std::nullopt,
+        .dimension = dimension.value()
+    };
+}
+
+template<typename Point>
+auto readPoints(std::string_view bytes, const CacheOffsets& offsets, size_t count) -> std::vector<Point>
+{
+    static constexpr auto dimension = std::is_same_v<Point, Point3d> ? 3 : 2;
+
+    auto points = std::vector<Point>(count);
+
+    for (auto i = size_t {}; i < count; i++)
+    {
+        auto values = std::array<double, dimension> {};
+        std::memcpy(&points[i].id, bytes.data() + offsets.ids + i * sizeof(uint32_t), sizeof(uint32_t));
+        std::memcpy(values.data(), bytes.data() + offsets.values + i * sizeof(values), sizeof(values));
+
+        points[i].x = values[0];
+        points[i].y = values[1];
+        if constexpr (dimension == 3)
+        {
+            points[i].z = values[2];
+        }
+    }
+
+    return points;
+}
+
+auto getCoordinatesDimension(const std::optional<Coordinates>& coordinates) -> uint32_t
+{
+    if (!coordinates)
+    {
+        return 0;
+    }
+
+    return std::holds_alternative<std::vector<Point2d>>(*coordinates) ? 2 : 3;
+}
+
+auto getCoordinatesCount(const std::optional<Coordinates>& coordinates) -> size_t
+{
+    if (!coordinates)
+    {
+        return 0;
+    }
+
+    return std::visit([](const auto& points) { return points.size(); }, *coordinates);
+}
+
+auto writePadding(std::ostream& output, size_t from, size_t to) -> void
+{
+    static constexpr auto zeros = std::array<char, WEIGHTS_ALIGNMENT> {};
+    output.write(zeros.data(), static_cast<std::streamsize>(to - from));
+}
+
+/**
+ * Offsets of the parts of the graph, the end is the size of the whole cache
+ */
+struct GraphOffsets
+{
+    size_t weightsCount;
+    size_t columns;
+    size_t rowOffsets;
+    size_t end;
+};
+
+/**
+ * Sizes are checked against the file size by the caller, so nothing can overflow
+ */
+auto getGraphOffsets(GraphRepresentation representation, size_t order, size_t size, size_t weightsOffset) -> GraphOffsets
+{
+    switch (representation)
+    {
+    case GraphRepresentation::SPARSE_ROWS:
+    {
+        const auto columns = alignedUp(weightsOffset + size * sizeof(Graph::Weight), alignof(uint64_t));
+        const auto rowOffsets = columns + size * sizeof(Graph::Vertex);
+        return {size, columns, rowOffsets, rowOffsets + (order + 1) * sizeof(size_t)};
+    }
+    case GraphRepresentation::PACKED_SYMMETRIC:
+    {
+        const auto count = order * (order - std::min<size_t>(order, 1)) / 2;
+        return {count, 0, 0, weightsOffset + count * sizeof(Graph::Weight)};
+    }
+    default:
+        return {order * order, 0, 0, weightsOffset + order * order * sizeof(Graph::Weight)};
+    }
+}
+
+template<typename T>
+auto writeValues(std::ostream& output, std::span<const T> values) -> void
+{
+    output.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size_bytes()));
+}
+
+/**
+ * Every representation is written as the graph keeps it, so a sparse or packed graph takes as little space on disk
+ */
+auto writeGraph(std::ostream& output, const Graph& graph, const GraphOffsets& offsets, size_t weightsOffset) -> void
+{
+    const auto order = graph.getOrder();
+
+    switch (graph.getRepresentation())
+    {
+    case GraphRepresentation::SPARSE_ROWS:
+    {
+        auto columns = std::vector<Graph::Vertex> {};
+        auto weights = std::vector<Graph::Weight> {};
+        auto rowOffsets = std::vector<size_t> {0};
+        columns.reserve(graph.getSize());
+        weights.reserve(graph.getSize());
+        rowOffsets.reserve(order + 1);
+
+        for (auto vertex = Graph::Vertex {}; vertex < order; vertex++)
+        {
+            graph.forEachNeighbourOf(vertex, [&columns, &weights](Graph::Neighbour neighbour) {
+                columns.push_back(neighbour.vertex);
+                weights.push_back(neighbour.weight);
+            });
+            rowOffsets.push_back(columns.size());
+        }
+
+        writeValues<Graph::Weight>(output, weights);
+        writePadding(output, weightsOffset + weights.size() * sizeof(Graph::Weight), offsets.columns);
+        writeValues<Graph::Vertex>(output, columns);
+        writeValues<size_t>(output, rowOffsets);
+        return;
+    }
+    case GraphRepresentation::PACKED_SYMMETRIC:
+    {
+        auto rowBuffer = std::vector<Graph::Weight>(order);
+        for (auto vertex = Graph::Vertex {}; vertex < order; vertex++)
+        {
+            writeValues(output, graph.getRow(vertex, rowBuffer).first(vertex));
+        }
+        return;
+    }
+    default:
+        for (auto vertex = Graph::Vertex {}; vertex < order; vertex++)
+        {
+            writeValues(output, graph.getRow(vertex));
+        }
+        return;
+    }
+}
+
+/**
+ * The graph relies on the row offsets growing up to the size and on the columns of a row ascending within the order
+ */
+auto areSparseRowsValid(std::string_view bytes, const GraphOffsets& offsets, size_t order) -> bool
+{
+    const auto read = [bytes](size_t offset) {
+        auto value = uint64_t {};
+        std::memcpy(&value, bytes.data() + offset, sizeof(value));
+        return value;
+    };
+
+    if (read(offsets.rowOffsets) != 0 || read(offsets.rowOffsets + order * sizeof(size_t)) != offsets.weightsCount)
+    {
+        return false;
+    }
+
+    for (auto vertex = size_t {}; vertex < order; vertex++)
+    {
+        const auto rowBegin = read(offsets.rowOffsets + vertex * sizeof(size_t));
+        const auto rowEnd = read(offsets.rowOffsets + (vertex + 1) * sizeof(size_t));
+
+        if (rowEnd < rowBegin || rowEnd > offsets.weightsCount)
+        {
+            return false;
+        }
+
+        for (auto i = rowBegin; i < rowEnd; i++)
+        {
+            const auto column = read(offsets.columns + i * sizeof(Graph::Vertex));
+
+            if (column >= order || (i > rowBegin && column <= read(offsets.columns + (i - 1) * sizeof(Graph::Vertex))))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+}
+
+auto contentHash(std::string_view input) -> uint64_t
+{
+    static constexpr auto prime = uint64_t {0x100000001B3};
+
+    auto hash = uint64_t {0xCBF29CE484222325} ^ input.size();
+    auto position = size_t {};
+
+    for (; position + sizeof(uint64_t) <= input.size(); position += sizeof(uint64_t))
+    {
+        auto word = uint64_t {};
+        std::memcpy(&word, input.data() + position, sizeof(word));
+        // The rotation brings the high bits of the product back down, a multiplication only carries upwards
+        hash = std::rotl((hash ^ word) * prime, 29);
+    }
+
+    for (; position < input.size(); position++)
+    {
+        hash = (hash ^ static_cast<uint8_t>(input[position])) * prime;
+    }
+
+    return hash;
+}
+
+auto writeCache(std::ostream& output, const Content& content, uint64_t sourceHash) -> bool
+{
+    const auto metaData = serializedMetaData(content.metaData);
+    const auto coordinatesCount = getCoordinatesCount(content.coordinates);
+    const auto coordinatesDimension = getCoordinatesDimension(content.coordinates);
+    const auto offsets = getOffsets(metaData.size(), coordinatesCount, coordinatesDimension);
+    const auto& graph = content.graph;
+    const auto graphOffsets = getGraphOffsets(graph.getRepresentation(), graph.getOrder(), graph.getSize(), offsets.weights);
+
+    const auto header = CacheHeader {
+        .magic = MAGIC,
+        .version = CACHE_VERSION,
+        .byteOrder = BYTE_ORDER_MARK,
+        .sourceHash = sourceHash,
+        .order = graph.getOrder(),
+        .size = graph.getSize(),
+        .metaDataSize = metaData.size(),
+        .coordinatesCount = coordinatesCount,
+        .coordinatesDimension = coordinatesDimension,
+        .representation = static_cast<uint32_t>(graph.getRepresentation()),
+        .weightsOffset = offsets.weights
+    };
+
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.write(metaData.data(), static_cast<std::streamsize>(metaData.size()));
+    writePadding(output, sizeof(header) + metaData.size(), offsets.ids);
+
+    if (content.coordinates)
+    {
+        std::visit([&output, &offsets](const auto& points) {
+            for (const auto& point : points)
+            {
+                output.write(reinterpret_cast<const char*>(&point.id), sizeof(point.id));
+            }
+            writePadding(output, offsets.ids + points.size() * sizeof(uint32_t), offsets.values);
+
+            for (const auto& point : points)
+            {
+                if constexpr (std::is_same_v<std::decay_t<decltype(point)>, Point3d>)
+                {
+                    const auto values = std::array {point.x, point.y, point.z};
+                    output.write(reinterpret_cast<const char*>(values.data()), sizeof(values));
+                }
+                else
+                {
+                    const auto values = std::array {point.x, point.y};
+                    output.write(reinterpret_cast<const char*>(values.data()), sizeof(values));
+                }
+            }
+        }, *content.coordinates);
+    }
+    else
+    {
+        writePadding(output, offsets.ids, offsets.values);
+    }
+    writePadding(output, offsets.values + coordinatesCount * coordinatesDimension * sizeof(double), offsets.weights);
+
+    writeGraph(output, graph, graphOffsets, offsets.weights);
+
+    return static_cast<bool>(output.flush());
+}
+
+auto readCache(std::string_view bytes) -> std::optional<CacheLayout>
+{
+    auto header = CacheHeader {};
+
+    if (bytes.size() < sizeof(header))
+    {
+        return {};
+    }
+
+    std::memcpy(&header, bytes.data(), sizeof(header));
+
+    if (header.magic != MAGIC || header.version != CACHE_VERSION || header.byteOrder != BYTE_ORDER_MARK)
+    {
+        return {};
+    }
+
+    const auto representation = static_cast<GraphRepresentation>(header.representation);
+
+    // Every size is checked against the file size before it is multiplied, so nothing can overflow.
+    // The order fits in 32 bits, so counting the weights of a matrix or a triangle cannot overflow either.
+    if (header.metaDataSize > bytes.size() || header.coordinatesCount > bytes.size() ||
+        (header.coordinatesDimension != 0 && header.coordinatesDimension != 2 && header.coordinatesDimension != 3) ||
+        header.representation > static_cast<uint32_t>(GraphRepresentation::PACKED_SYMMETRIC) ||
+        header.order > std::numeric_limits<uint32_t>::max() || header.order > bytes.size() || header.size > bytes.size() ||
+        getGraphOffsets(representation, header.order, header.size, 0).weightsCount > bytes.size() / sizeof(Graph::Weight))
+    {
+        return {};
+    }
+
+    const auto offsets = getOffsets(header.metaDataSize, header.coordinatesCount, header.coordinatesDimension);
+    const auto graphOffsets = getGraphOffsets(representation, header.order, header.size, offsets.weights);
+
+    if (offsets.weights != header.weightsOffset || bytes.size() != graphOffsets.end)
+    {
+        return {};
+    }
+
+    if (representation == GraphRepresentation::SPARSE_ROWS && !areSparseRowsValid(bytes, graphOffsets, header.order))
+    {
+        return {};
+    }
+
+    auto metaData = readMetaData(bytes.substr(sizeof(header), header.metaDataSize));
+
+    if (!metaData)
+    {
+        return {};
+    }
+
+    auto coordinates = std::optional<Coordinates> {};
+
+    if (header.coordinatesDimension == 2)
+    {
+        coordinates = readPoints<Point2d>(bytes, offsets, header.coordinatesCount);
+    }
+    else if (header.coordinatesDimension == 3)
+    {
+        coordinates = readPoints<Point3d>(bytes, offsets, header.coordinatesCount);
+    }
+
+    return CacheLayout {
+        .metaData = std::move(metaData.value()),
+        .coordinates = std::move(coordinates),
+        .sourceHash = header.sourceHash,
+        .representation = representation,
+        .order = header.order,
+        .size = header.size,
+        .weightsOffset = offsets.weights,
+        .weightsCount = graphOffsets.weightsCount,
+        .columnsOffset = graphOffsets.columns,
+        .rowOffsetsOffset = graphOffsets.rowOffsets
+    };
+}
+
+}
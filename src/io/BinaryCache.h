@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Content.h"
+
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string_view>
+
+namespace tsplib
+{
+
+/**
+ * Bumped whenever the layout changes, caches of other versions are rebuilt
+ */
+inline constexpr auto CACHE_VERSION = uint32_t {2};
+
+/**
+ * Everything stored in a cache except the graph, which is left in place in the representation it had
+ */
+struct CacheLayout
+{
+    MetaData metaData;
+    std::optional<Coordinates> coordinates;
+    uint64_t sourceHash;
+    GraphRepresentation representation;
+    size_t order;
+    size_t size;
+    /**
+     * Byte offset of the weights, a multiple of 64. They are the row-major order x order matrix,
+     * the lower triangle without the diagonal row by row, or the weights of the sparse rows one row after another.
+     */
+    size_t weightsOffset;
+    size_t weightsCount;
+    /**
+     * Byte offsets of the column of each weight and of the order + 1 row offsets, only used by sparse rows
+     */
+    size_t columnsOffset;
+    size_t rowOffsetsOffset;
+};
+
+/**
+ * Hash of a whole instance, eight bytes are mixed at once so that it costs far less than parsing
+ */
+[[nodiscard]]
+auto contentHash(std::string_view input) -> uint64_t;
+
+auto writeCache(std::ostream& output, const Content& content, uint64_t sourceHash) -> bool;
+
+/**
+ * Returns nothing if the bytes are not a cache of the current version written on a machine of the same byte order
+ */
+[[nodiscard]]
+auto readCache(std::string_view bytes) -> std::optional<CacheLayout>;
+
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "utils/Numbers.h"
+
+#include <charconv>
+#include <concepts>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+namespace tsplib
+{
+
+/**
+ * Collects the output in a large buffer which is handed to the stream in big writes.
+ * Numbers are formatted with std::to_chars straight into the buffer.
+ */
+class BufferedWriter
+{
+public:
+    static constexpr auto DEFAULT_CAPACITY = size_t {1} << 20;
+
+    explicit BufferedWriter(std::ostream& output, size_t capacity = DEFAULT_CAPACITY)
+        : output {output}
+        , buffer(std::max(capacity, MIN_CAPACITY))
+    {
+
+    }
+
+    BufferedWriter(const BufferedWriter&) = delete;
+    auto operator=(const BufferedWriter&) -> BufferedWriter& = delete;
+
+    ~BufferedWriter()
+    {
+        flush();
+    }
+
+    auto write(std::string_view text) -> BufferedWriter&
+    {
+        while (!text.empty())
+        {
+            if (used == buffer.size())
+            {
+                flush();
+            }
+
+            const auto size = std::min(text.size(), buffer.size() - used);
+            text.copy(buffer.data() + used, size);
+            used += size;
+            text.remove_prefix(size);
+        }
+
+        return *this;
+    }
+
+    auto write(char symbol) -> BufferedWriter&
+    {
+        if (used == buffer.size())
+        {
+            flush();
+        }
+
+        buffer[used++] = symbol;
+        return *this;
+    }
+
+    template<typename T>
+        requires std::integral<T> || std::floating_point<T>
+    auto write(T number) -> BufferedWriter&
+    {
+        static constexpr auto maxLength = size_t {utils::maxLengthOfType<T>()};
+
+#if !defined(__cpp_lib_to_chars)
+        if constexpr (std::floating_point<T>)
+        {
+            return write(std::string_view {utils::numberToString(number)});
+        }
+#endif
+
+        if (buffer.size() - used < maxLength)
+        {
+            flush();
+        }
+
+        const auto end = std::to_chars(buffer.data() + used, buffer.data() + buffer.size(), number).ptr;
+        used = static_cast<size_t>(end - buffer.data());
+
+        return *this;
+    }
+
+    /**
+     * Returns false if the stream failed to take any of the output so far
+     */
+    auto flush() -> bool
+    {
+        if (used != 0)
+        {
+            output.write(buffer.data(), static_cast<std::streamsize>(used));
+            used = 0;
+        }
+
+        return static_cast<bool>(output);
+    }
+
+private:
+    static constexpr auto MIN_CAPACITY = size_t {utils::maxLengthOfType<long double>()};
+
+    std::ostream& output;
+    std::vector<char> buffer;
+    size_t used = 0;
+};
+
+}
@@ -0,0 +1,135 @@
+#include "FileInput.h"
+
+#include <array>
+#include <fstream>
+#include <utility>
+
+#ifdef TSPLIB_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace tsplib
+{
+
+auto FileInput::open(const std::filesystem::path& path) -> std::optional<FileInput>
+{
+#ifdef TSPLIB_HAS_MMAP
+    const auto descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+    {
+        return {};
+    }
+
+    struct stat status {};
+    if (::fstat(descriptor, &status) != 0)
+    {
+        ::close(descriptor);
+        return {};
+    }
+
+    if (!S_ISREG(status.st_mode) || status.st_size == 0)
+    {
+        ::close(descriptor);
+        return read(path);
+    }
+
+    const auto size = static_cast<size_t>(status.st_size);
+    auto* const mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor);
+
+    if (mapping == MAP_FAILED)
+    {
+        return read(path);
+    }
+
+    ::madvise(mapping, size, MADV_SEQUENTIAL);
+
+    auto result = FileInput {};
+    result.mapping = mapping;
+    result.mappingSize = size;
+
+    return result;
+#else
+    return read(path);
+#endif
+}
+
+auto FileInput::read(const std::filesystem::path& path) -> std::optional<FileInput>
+{
+    auto file = std::ifstream {path, std::ios::binary};
+    if (!file)
+    {
+        return {};
+    }
+
+    auto result = FileInput {};
+    auto chunk = std::array<char, 1 << 16> {};
+
+    while (file.read(chunk.data(), chunk.size()) || file.gcount() > 0)
+    {
+        result.buffer.append(chunk.data(), static_cast<size_t>(file.gcount()));
+    }
+
+    if (file.bad())
+    {
+        return {};
+    }
+
+    return result;
+}
+
+FileInput::FileInput(FileInput&& other) noexcept
+    : mapping {std::exchange(other.mapping, nullptr)}
+    , mappingSize {std::exchange(other.mappingSize, 0)}
+    , buffer {std::move(other.buffer)}
+{
+
+}
+
+FileInput::~FileInput()
+{
+    unmap();
+}
+
+auto FileInput::operator=(FileInput&& other) noexcept -> FileInput&
+{
+    if (this != &other)
+    {
+        unmap();
+        mapping = std::exchange(other.mapping, nullptr);
+        mappingSize = std::exchange(other.mappingSize, 0);
+        buffer = std::move(other.buffer);
+    }
+    return *this;
+}
+
+auto FileInput::getContent() const -> std::string_view
+{
+    if (isMapped())
+    {
+        return {static_cast<const char*>(mapping), mappingSize};
+    }
+    return buffer;
+}
+
+auto FileInput::isMapped() const -> bool
+{
+    return mapping != nullptr;
+}
+
+auto FileInput::unmap() -> void
+{
+#ifdef TSPLIB_HAS_MMAP
+    if (mapping != nullptr)
+    {
+        ::munmap(mapping, mappingSize);
+        mapping = nullptr;
+        mappingSize = 0;
+    }
+#endif
+}
+
+}
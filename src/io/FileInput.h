@@ -0,0 +1,50 @@
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+#define TSPLIB_HAS_MMAP
+#endif
+
+namespace tsplib
+{
+
+/**
+ * Read-only view of a whole file. Regular files are memory mapped for sequential access,
+ * anything else (pipes, character devices, platforms without mmap) is read into a buffer.
+ */
+class FileInput
+{
+public:
+    [[nodiscard]]
+    static auto open(const std::filesystem::path& path) -> std::optional<FileInput>;
+
+    FileInput(const FileInput&) = delete;
+    FileInput(FileInput&& other) noexcept;
+    ~FileInput();
+
+    auto operator=(const FileInput&) -> FileInput& = delete;
+    auto operator=(FileInput&& other) noexcept -> FileInput&;
+
+    [[nodiscard]]
+    auto getContent() const -> std::string_view;
+    [[nodiscard]]
+    auto isMapped() const -> bool;
+
+private:
+    FileInput() = default;
+
+    [[nodiscard]]
+    static auto read(const std::filesystem::path& path) -> std::optional<FileInput>;
+
+    auto unmap() -> void;
+
+    void* mapping = nullptr;
+    size_t mappingSize = 0;
+    std::string buffer;
+};
+
+}
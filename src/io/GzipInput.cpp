@@ -0,0 +1,100 @@
+#include "GzipInput.h"
+
+#ifdef TSPLIB_HAS_ZLIB
+#include <zlib.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+#endif
+
+namespace tsplib
+{
+
+auto isGzip(std::string_view input) -> bool
+{
+    return input.starts_with("\x1F\x8B");
+}
+
+#ifdef TSPLIB_HAS_ZLIB
+
+auto gunzip(std::string_view input, const ChunkConsumer& consumer) -> bool
+{
+    static constexpr auto chunkSize = size_t {1} << 16;
+    // 16 added to the window bits makes zlib expect a gzip header and trailer
+    static constexpr auto gzipWindowBits = 15 + 16;
+
+    auto stream = z_stream {};
+
+    if (inflateInit2(&stream, gzipWindowBits) != Z_OK)
+    {
+        return false;
+    }
+
+    auto chunk = std::vector<char>(chunkSize);
+    auto remaining = input;
+    auto isCorrect = true;
+
+    while (true)
+    {
+        if (stream.avail_in == 0)
+        {
+            // avail_in is only 32 bits wide
+            const auto size = std::min<size_t>(remaining.size(), std::numeric_limits<uInt>::max());
+            stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(remaining.data()));
+            stream.avail_in = static_cast<uInt>(size);
+            remaining.remove_prefix(size);
+        }
+
+        stream.next_out = reinterpret_cast<Bytef*>(chunk.data());
+        stream.avail_out = static_cast<uInt>(chunk.size());
+
+        const auto status = inflate(&stream, Z_NO_FLUSH);
+        const auto produced = chunk.size() - stream.avail_out;
+
+        if (produced != 0 && !consumer(std::span {chunk}.first(produced)))
+        {
+            isCorrect = false;
+            break;
+        }
+
+        if (status == Z_STREAM_END)
+        {
+            if (stream.avail_in == 0 && remaining.empty())
+            {
+                break;
+            }
+
+            // A gzip file may consist of several members
+            if (inflateReset(&stream) != Z_OK)
+            {
+                isCorrect = false;
+                break;
+            }
+            continue;
+        }
+
+        const auto needsInput = status == Z_BUF_ERROR && stream.avail_in == 0 && !remaining.empty();
+
+        if (status != Z_OK && !needsInput)
+        {
+            isCorrect = false;
+            break;
+        }
+    }
+
+    inflateEnd(&stream);
+
+    return isCorrect;
+}
+
+#else
+
+auto gunzip([[maybe_unused]] std::string_view input, [[maybe_unused]] const ChunkConsumer& consumer) -> bool
+{
+    return false;
+}
+
+#endif
+
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <functional>
+#include <span>
+#include <string_view>
+
+namespace tsplib
+{
+
+/**
+ * Receives decompressed text, returning false stops the decompression
+ */
+using ChunkConsumer = std::function<bool(std::span<const char>)>;
+
+[[nodiscard]]
+auto isGzip(std::string_view input) -> bool;
+
+/**
+ * Decompresses all gzip members of the input one chunk at a time, so the whole text is never held in memory.
+ * Returns false if the data is corrupted or truncated, the consumer refused a chunk or zlib is not available.
+ */
+[[nodiscard]]
+auto gunzip(std::string_view input, const ChunkConsumer& consumer) -> bool;
+
+}
@@ -0,0 +1,281 @@
+#include "Writer.h"
+#include "BufferedWriter.h"
+
+#include <fstream>
+#include <sstream>
+#include <variant>
+
+namespace tsplib
+{
+
+namespace
+{
+
+/**
+ * Columns of a row written by a format, the diagonal is at the vertex itself
+ */
+struct ColumnRange
+{
+    size_t begin;
+    size_t end;
+};
+
+auto typeName(Type type) -> std::string_view
+{
+    switch (type)
+    {
+    case Type::TSP:
+        return "TSP";
+    case Type::ATSP:
+        return "ATSP";
+    case Type::SOP:
+        return "SOP";
+    case Type::HCP:
+        return "HCP";
+    case Type::CRVP:
+        return "CRVP";
+    case Type::TOUR:
+        return "TOUR";
+    }
+
+    return {};
+}
+
+/**
+ * Graphs are symmetric, so each *_COL format lists the same numbers as the opposite *_ROW one
+ */
+auto rowFormat(MatrixFormat format) -> MatrixFormat
+{
+    switch (format)
+    {
+    case MatrixFormat::UPPER_COL:
+        return MatrixFormat::LOWER_ROW;
+    case MatrixFormat::LOWER_COL:
+        return MatrixFormat::UPPER_ROW;
+    case MatrixFormat::UPPER_DIAG_COL:
+        return MatrixFormat::LOWER_DIAG_ROW;
+    case MatrixFormat::LOWER_DIAG_COL:
+        return MatrixFormat::UPPER_DIAG_ROW;
+    default:
+        return format;
+    }
+}
+
+auto formatName(MatrixFormat format) -> std::string_view
+{
+    switch (format)
+    {
+    case MatrixFormat::FULL_MATRIX:
+        return "FULL_MATRIX";
+    case MatrixFormat::UPPER_ROW:
+        return "UPPER_ROW";
+    case MatrixFormat::LOWER_ROW:
+        return "LOWER_ROW";
+    case MatrixFormat::UPPER_DIAG_ROW:
+        return "UPPER_DIAG_ROW";
+    case MatrixFormat::LOWER_DIAG_ROW:
+        return "LOWER_DIAG_ROW";
+    case MatrixFormat::UPPER_COL:
+        return "UPPER_COL";
+    case MatrixFormat::LOWER_COL:
+        return "LOWER_COL";
+    case MatrixFormat::UPPER_DIAG_COL:
+        return "UPPER_DIAG_COL";
+    case MatrixFormat::LOWER_DIAG_COL:
+        return "LOWER_DIAG_COL";
+    }
+
+    return {};
+}
+
+auto columnRange(MatrixFormat format, Graph::Vertex vertex, size_t order) -> ColumnRange
+{
+    switch (format)
+    {
+    case MatrixFormat::UPPER_ROW:
+        return {vertex + 1, order};
+    case MatrixFormat::LOWER_ROW:
+        return {0, vertex};
+    case MatrixFormat::UPPER_DIAG_ROW:
+        return {vertex, order};
+    case MatrixFormat::LOWER_DIAG_ROW:
+        return {0, vertex + 1};
+    default:
+        return {0, order};
+    }
+}
+
+auto isSymmetric(const Graph& graph) -> bool
+{
+    if (graph.getRepresentation() == Graph::Representation::PACKED_SYMMETRIC)
+    {
+        return true;
+    }
+
+    auto rowBuffer = std::vector<Graph::Weight>(graph.getOrder());
+
+    for (auto from = Graph::Vertex {0}; from < graph.getOrder(); ++from)
+    {
+        const auto row = graph.getRow(from, rowBuffer);
+
+        for (auto to = from + 1; to < graph.getOrder(); ++to)
+        {
+            if (row[to] != graph.getWeightUnchecked({to, from}))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+auto writeHeader(BufferedWriter& writer, const Content& content, MatrixFormat format) -> void
+{
+    const auto& metaData = content.metaData;
+
+    if (metaData.name)
+    {
+        writer.write("NAME: ").write(*metaData.name).write('\n');
+    }
+    if (metaData.type)
+    {
+        writer.write("TYPE: ").write(typeName(*metaData.type)).write('\n');
+    }
+    if (metaData.comment)
+    {
+        writer.write("COMMENT: ").write(*metaData.comment).write('\n');
+    }
+
+    writer.write("DIMENSION: ").write(content.graph.getOrder()).write('\n');
+    writer.write("EDGE_WEIGHT_TYPE: EXPLICIT\n");
+    writer.write("EDGE_WEIGHT_FORMAT: ").write(formatName(format)).write('\n');
+
+    if (content.coordinates)
+    {
+        const auto is3d = std::holds_alternative<std::vector<Point3d>>(*content.coordinates);
+        writer.write(is3d ? "NODE_COORD_TYPE: THREED_COORDS\n" : "NODE_COORD_TYPE: TWOD_COORDS\n");
+    }
+}
+
+auto writeCoordinates(BufferedWriter& writer, const Coordinates& coordinates) -> void
+{
+    writer.write("NODE_COORD_SECTION\n");
+
+    std::visit([&writer](const auto& points) {
+        for (const auto& point : points)
+        {
+            writer.write(point.id).write(' ').write(point.x).write(' ').write(point.y);
+
+            if constexpr (requires { point.z; })
+            {
+                writer.write(' ').write(point.z);
+            }
+
+            writer.write('\n');
+        }
+    }, coordinates);
+}
+
+auto writeWeights(BufferedWriter& writer, const Graph& graph, MatrixFormat format) -> void
+{
+    writer.write("EDGE_WEIGHT_SECTION\n");
+
+    const auto order = graph.getOrder();
+    auto rowBuffer = std::vector<Graph::Weight>(order);
+
+    for (auto vertex = Graph::Vertex {0}; vertex < order; ++vertex)
+    {
+        const auto [begin, end] = columnRange(format, vertex, order);
+
+        if (begin == end)
+        {
+            continue;
+        }
+
+        const auto row = graph.getRow(vertex, rowBuffer);
+
+        for (auto column = begin; column < end; ++column)
+        {
+            if (column != begin)
+            {
+                writer.write(' ');
+            }
+
+            writer.write(column == vertex ? Graph::Weight {0} : row[column]);
+        }
+
+        writer.write('\n');
+    }
+}
+
+}
+
+auto writeTspContent(std::ostream& output, const Content& content, const WriteOptions& options) -> bool
+{
+    const auto format = rowFormat(options.format);
+
+    if (format != MatrixFormat::FULL_MATRIX && !isSymmetric(content.graph))
+    {
+        return false;
+    }
+
+    auto writer = BufferedWriter {output};
+
+    writeHeader(writer, content, options.format);
+
+    if (content.coordinates)
+    {
+        writeCoordinates(writer, *content.coordinates);
+    }
+
+    writeWeights(writer, content.graph, format);
+    writer.write("EOF\n");
+
+    return writer.flush();
+}
+
+auto writeTspContentToFile(const std::filesystem::path& path, const Content& content, const WriteOptions& options)
+    -> bool
+{
+    auto output = std::ofstream {path, std::ios::binary};
+
+    return output && writeTspContent(output, content, options);
+}
+
+auto tspContentToString(const Content& content, const WriteOptions& options) -> std::optional<std::string>
+{
+    auto output = std::ostringstream {};
+
+    if (!writeTspContent(output, content, options))
+    {
+        return {};
+    }
+
+    return std::move(output).str();
+}
+
+auto writeTspTour(std::ostream& output, std::span<const Graph::Vertex> tour, std::string_view name) -> bool
+{
+    auto writer = BufferedWriter {output};
+
+    if (!name.empty())
+    {
+        writer.write("NAME: ").write(name).write('\n');
+    }
+
+    writer.write("TYPE: TOUR\n");
+    writer.write("DIMENSION: ").write(tour.size()).write('\n');
+    writer.write("TOUR_SECTION\n");
+
+    for (const auto vertex : tour)
+    {
+        writer.write(vertex + 1).write('\n');
+    }
+
+    writer.write("-1\nEOF\n");
+
+    return writer.flush();
+}
+
+}
@@ -1,105 +1,273 @@
 #include "GraphParser.h"
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <span>
 
 namespace tsplib
 {
 
-auto makeGraphFromFullMatrix(const std::vector<int32_t>& weights) -> std::optional<Graph>;
+namespace
+{
+
+enum class Triangle
+{
+    UPPER,
+    LOWER
+};
+
+struct TriangleLayout
+{
+    Triangle triangle;
+    bool hasDiagonal;
+};
 
-auto makeGraphFromWeights(const std::vector<int32_t>& weights, EdgeWeightFormat format) -> std::optional<Graph>
+/**
+ * Listing a triangle column by column gives the same sequence as listing the other triangle row by row,
+ * and all triangular formats describe symmetric instances, so each *_COL format is read as a *_ROW one
+ */
+auto getTriangleLayout(EdgeWeightFormat format) -> std::optional<TriangleLayout>
 {
     using enum EdgeWeightFormat;
     switch (format)
     {
-    case FULL_MATRIX:
-        return makeGraphFromFullMatrix(weights);
-        //TODO other formats
+    case UPPER_ROW:
+    case LOWER_COL:
+        return TriangleLayout {Triangle::UPPER, false};
+    case LOWER_ROW:
+    case UPPER_COL:
+        return TriangleLayout {Triangle::LOWER, false};
+    case UPPER_DIAG_ROW:
+    case LOWER_DIAG_COL:
+        return TriangleLayout {Triangle::UPPER, true};
+    case LOWER_DIAG_ROW:
+    case UPPER_DIAG_COL:
+        return TriangleLayout {Triangle::LOWER, true};
     default:
         return {};
     }
 }
 
-auto makeGraphFromFullMatrix(const std::vector<int32_t>& weights) -> std::optional<Graph>
+auto getTriangleSize(size_t order, bool hasDiagonal) -> size_t
 {
-    const auto size = static_cast<size_t>(std::llround(std::sqrt(weights.size())));
-    if (size * size != weights.size())
+    return hasDiagonal ? order * (order + 1) / 2 : order * (order - std::min<size_t>(order, 1)) / 2;
+}
+
+auto getTriangleOrder(size_t size, bool hasDiagonal) -> size_t
+{
+    const auto root = static_cast<size_t>(std::llround(std::sqrt(1.0 + 8.0 * static_cast<double>(size))));
+
+    return hasDiagonal ? (root - 1) / 2 : (root + 1) / 2;
+}
+
+/**
+ * Columns of the given row which are stored in the triangle, as a half-open range
+ */
+auto getRowColumns(size_t row, size_t order, TriangleLayout layout) -> std::pair<size_t, size_t>
+{
+    const auto diagonal = layout.hasDiagonal ? size_t {0} : size_t {1};
+
+    if (layout.triangle == Triangle::UPPER)
     {
-        return {};
+        return {row + diagonal, order};
     }
 
-    auto result = Graph{size};
+    return {0, row + 1 - diagonal};
+}
 
-    auto i = size_t {};
-    auto j = size_t {};
-    for (auto weight : weights)
+/**
+ * Rearranges the triangle into the lower one without the diagonal listed row by row, which Graph stores.
+ * Listing the upper triangle row by row is listing the lower one column by column, so it is transposed
+ * block by block to keep both the rows read and the rows written in the cache.
+ */
+template<GraphWeight W>
+auto packLowerTriangle(utils::AlignedVector<W> weights, size_t order, TriangleLayout layout) -> utils::AlignedVector<W>
+{
+    if (layout.triangle == Triangle::LOWER)
     {
-        result.addEdge({{j, i}, weight});
+        if (layout.hasDiagonal)
+        {
+            // Dropping the diagonal only moves the rows backward
+            auto packedEnd = weights.begin();
+            for (auto row = size_t {}; row < order; row++)
+            {
+                packedEnd = std::copy_n(weights.begin() + static_cast<std::ptrdiff_t>(row * (row + 1) / 2), row, packedEnd);
+            }
+            weights.resize(getTriangleSize(order, false));
+        }
 
-        if (++i == size)
+        // The packed graph keeps the buffer, so it must not hold more than the triangle
+        weights.shrink_to_fit();
+        return weights;
+    }
+
+    static constexpr auto blockSize = size_t {64};
+
+    auto packed = utils::AlignedVector<W>(getTriangleSize(order, false));
+    const auto diagonal = layout.hasDiagonal ? size_t {1} : size_t {0};
+
+    for (auto blockColumn = size_t {}; blockColumn < order; blockColumn += blockSize)
+    {
+        const auto blockEnd = std::min(blockColumn + blockSize, order);
+
+        for (auto row = size_t {}; row < blockEnd; row++)
         {
-            i = 0;
-            j++;
+            const auto rowStart = row * (order - 1 + diagonal) - row * (row - 1) / 2;
+            const auto firstColumn = getRowColumns(row, order, layout).first;
+
+            for (auto column = std::max(blockColumn, row + 1); column < blockEnd; column++)
+            {
+                packed[column * (column - 1) / 2 + row] = weights[rowStart + column - firstColumn];
+            }
         }
     }
 
-    return result;
+    return packed;
 }
 
-namespace detail
+template<GraphWeight W>
+auto makeGraphFromFullMatrix(utils::AlignedVector<W> weights,
+                             std::optional<size_t> dimension,
+                             bool isSymmetricType) -> std::optional<BasicGraph<W>>
 {
+    const auto order = dimension.value_or(static_cast<size_t>(std::llround(std::sqrt(weights.size()))));
+
+    return BasicGraph<W>::fromWeights(std::move(weights), order, isSymmetricType);
+}
 
-auto makeEdgeList(const std::vector<int32_t>& edgeData) -> std::optional<std::vector<Graph::Edge>>
+template<GraphWeight W>
+auto makeGraphFromTriangle(utils::AlignedVector<W> weights,
+                           TriangleLayout layout,
+                           std::optional<size_t> dimension) -> std::optional<BasicGraph<W>>
 {
-    if ((edgeData.size() - 1) % 2 != 0 || edgeData.back() != -1)
+    const auto order = dimension.value_or(getTriangleOrder(weights.size(), layout.hasDiagonal));
+
+    if (getTriangleSize(order, layout.hasDiagonal) != weights.size())
     {
         return {};
     }
 
-    if (edgeData.empty())
+    return BasicGraph<W>::fromSymmetricWeights(packLowerTriangle(std::move(weights), order, layout), order);
+}
+
+}
+
+template<GraphWeight W>
+auto makeGraphFromWeights(utils::AlignedVector<W> weights,
+                          EdgeWeightFormat format,
+                          std::optional<size_t> dimension,
+                          bool isSymmetricType) -> std::optional<BasicGraph<W>>
+{
+    if (format == EdgeWeightFormat::FULL_MATRIX)
+    {
+        return makeGraphFromFullMatrix(std::move(weights), dimension, isSymmetricType);
+    }
+
+    if (const auto layout = getTriangleLayout(format))
     {
-        return {{}};
+        return makeGraphFromTriangle(std::move(weights), layout.value(), dimension);
+    }
 
+    return {};
+}
+
+template<GraphWeight W>
+auto getWeightsCapacity(EdgeWeightFormat format, size_t dimension) -> size_t
+{
+    if (const auto layout = getTriangleLayout(format))
+    {
+        return getTriangleSize(dimension, layout->hasDiagonal);
     }
+
+    return dimension * BasicGraph<W>::paddedStride(dimension);
+}
+
+template auto makeGraphFromWeights(utils::AlignedVector<int16_t> weights,
+                                   EdgeWeightFormat format,
+                                   std::optional<size_t> dimension,
+                                   bool isSymmetricType) -> std::optional<BasicGraph<int16_t>>;
+template auto makeGraphFromWeights(utils::AlignedVector<int32_t> weights,
+                                   EdgeWeightFormat format,
+                                   std::optional<size_t> dimension,
+                                   bool isSymmetricType) -> std::optional<BasicGraph<int32_t>>;
+template auto makeGraphFromWeights(utils::AlignedVector<float> weights,
+                                   EdgeWeightFormat format,
+                                   std::optional<size_t> dimension,
+                                   bool isSymmetricType) -> std::optional<BasicGraph<float>>;
+
+template auto getWeightsCapacity<int16_t>(EdgeWeightFormat format, size_t dimension) -> size_t;
+template auto getWeightsCapacity<int32_t>(EdgeWeightFormat format, size_t dimension) -> size_t;
+template auto getWeightsCapacity<float>(EdgeWeightFormat format, size_t dimension) -> size_t;
+
+namespace detail
+{
+
+auto makeEdgeList(const utils::AlignedVector<int32_t>& edgeData) -> std::optional<std::vector<Graph::Edge>>
+{
+    if (edgeData.empty() || edgeData.size() % 2 != 1 || edgeData.back() != -1)
+    {
+        return {};
+    }
+
     auto result = std::vector<Graph::Edge> {};
-    result.reserve((edgeData.size() - 1) / 2);
+    result.reserve(edgeData.size() / 2);
 
-    for (auto i = size_t {}; i < edgeData.size() - 1; i += 2)
+    for (auto i = size_t {}; i + 1 < edgeData.size(); i += 2)
     {
+        if (edgeData[i] < 0 || edgeData[i + 1] < 0)
+        {
+            return {};
+        }
+
         result.emplace_back(edgeData[i], edgeData[i + 1]);
     }
 
     return result;
 }
 
-auto makeAdjacencyList(const std::vector<int32_t>& edgeData) -> std::optional<std::vector<std::vector<Graph::Vertex>>>
+auto makeAdjacencyList(const utils::AlignedVector<int32_t>& edgeData) -> std::optional<std::vector<Graph::Edge>>
 {
-    if (edgeData.empty())
+    if (edgeData.empty() || edgeData.back() != -1)
     {
-        return {{}};
+        return {};
     }
 
-    const auto [minNodeNumber, maxNodeNumber] = std::ranges::minmax_element(edgeData);
+    auto result = std::vector<Graph::Edge> {};
+    auto head = Graph::Vertex {};
+    auto inList = false;
 
-    if (*maxNodeNumber < 0 || *minNodeNumber < -1)
+    // The last -1 ends the section, every -1 before it ends the list of the current head
+    for (const auto node : std::span {edgeData}.first(edgeData.size() - 1))
     {
-        return {};
+        if (node == -1)
+        {
+            if (!inList)
+            {
+                return {};
+            }
+            inList = false;
+        }
+        else if (node < 0)
+        {
+            return {};
+        }
+        else if (!inList)
+        {
+            head = static_cast<Graph::Vertex>(node);
+            inList = true;
+        }
+        else
+        {
+            result.emplace_back(head, static_cast<Graph::Vertex>(node));
+        }
     }
 
-    auto result = std::vector<std::vector<Graph::Vertex>>();
-    result.reserve(static_cast<size_t>(*maxNodeNumber) + 1);
-
-    for (const auto adjacency : edgeData | std::ranges::views::split(-1))
+    if (inList)
     {
-        const auto unsignedAdjacency = adjacency
-                                       | std::ranges::views::transform(
-            [](auto vertex) { return static_cast<Graph::Vertex>(vertex); })
-                                       | std::ranges::views::common;
-
-        auto adjacencyVec = std::vector(std::next(unsignedAdjacency.begin()), unsignedAdjacency.end());
-        result.push_back(std::move(adjacencyVec));
+        return {};
     }
+
     return result;
 }
 
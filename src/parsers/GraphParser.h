@@ -7,114 +7,150 @@
 
 namespace tsplib
 {
+/**
+ * Nodes are numbered from 1 as in the instance, node i becomes vertex i - 1. The order is the dimension,
+ * or the largest node number if it is not given. Fails if an edge refers to a node beyond the order.
+ */
 [[nodiscard]]
-auto makeGraphFromEdgeData(const std::vector<int32_t>& edgeData,
+auto makeGraphFromEdgeData(const utils::AlignedVector<int32_t>& edgeData,
                            EdgeDataFormat format,
                            std::ranges::range auto&& nodes,
-                           DistanceFunction auto distanceFunction) -> std::optional<Graph>;
-
+                           DistanceFunction auto distanceFunction,
+                           std::optional<size_t> dimension = {}) -> std::optional<Graph>;
+
+/**
+ * Supports FULL_MATRIX, whose rows are spread inside the weights vector before it is moved into the graph,
+ * and all triangular formats, which are rearranged into the packed lower triangle.
+ * The dimension is derived from the number of weights if it is not given.
+ * Triangles are always packed, a full matrix only if the instance is symmetric by its type and it really is.
+ * Compiled for every GraphWeight, the graph gets the weight type of the vector.
+ */
+template<GraphWeight W = Graph::Weight>
+[[nodiscard]]
+auto makeGraphFromWeights(utils::AlignedVector<W> weights,
+                          EdgeWeightFormat format,
+                          std::optional<size_t> dimension = {},
+                          bool isSymmetricType = false) -> std::optional<BasicGraph<W>>;
+
+/**
+ * Room the weights of an EDGE_WEIGHT_SECTION need to become a graph of the weight type without being reallocated.
+ * A full matrix is spread to padded rows in place, a triangle is only packed, which never makes it larger.
+ */
+template<GraphWeight W = Graph::Weight>
 [[nodiscard]]
-auto makeGraphFromWeights(const std::vector<int32_t>& weights, EdgeWeightFormat format) -> std::optional<Graph>;
+auto getWeightsCapacity(EdgeWeightFormat format, size_t dimension) -> size_t;
 
 namespace detail
 {
 
+/**
+ * Nodes looked up by their number, node i is at i - 1. The first one wins if a number repeats.
+ */
 [[nodiscard]]
-auto makeGraphFromEdgeList(const std::vector<Graph::Edge>& edgeList,
-                           std::ranges::range auto&& nodes,
-                           DistanceFunction auto distanceFunction) -> Graph
+auto indexNodesById(std::ranges::range auto&& nodes, size_t count)
 {
-    const auto vertexCount = std::ranges::max_element(edgeList, [](auto edge1, auto edge2) {
-        return std::max(edge1.first, edge1.second) > std::max(edge2.first, edge2.second);
-    });
+    using Node = std::ranges::range_value_t<decltype(nodes)>;
 
-    auto result = Graph {std::max(vertexCount->first, vertexCount->second)};
+    auto result = std::vector<const Node*>(count, nullptr);
 
-    for (auto edge : edgeList)
+    for (const auto& node : nodes)
     {
-        const auto begin = std::ranges::find(nodes, edge.first, [](const auto& node) { return node.id; });
-        const auto end   = std::ranges::find(nodes, edge.second, [](const auto& node) { return node.id; });
-
-        if (begin != nodes.end() && end != nodes.end())
+        if (node.id >= 1 && node.id <= count && result[node.id - 1] == nullptr)
         {
-            result.addEdge({edge, distanceFunction(*begin, *end)});
+            result[node.id - 1] = &node;
         }
     }
 
     return result;
 }
 
+/**
+ * Edges are pairs of node numbers. Edges between nodes without coordinates are left out.
+ */
 [[nodiscard]]
-auto makeGraphFromAdjacencyList(const std::vector<std::vector<Graph::Vertex>>& adjacencyList,
-                                std::ranges::range auto&& nodes,
-                                DistanceFunction auto distanceFunction) -> Graph
+auto makeGraphFromEdgeList(const std::vector<Graph::Edge>& edgeList,
+                           std::ranges::range auto&& nodes,
+                           DistanceFunction auto distanceFunction,
+                           std::optional<size_t> dimension) -> std::optional<Graph>
 {
-    const auto vertexCount = adjacencyList.size();
-
-    auto result = Graph {vertexCount};
+    auto largestNode = size_t {};
+    for (const auto& [from, to] : edgeList)
+    {
+        largestNode = std::max({largestNode, from, to});
+    }
 
-    for (auto i = size_t {}; i < adjacencyList.size(); i++)
+    const auto order = dimension.value_or(largestNode);
+    if (largestNode > order)
     {
-        const auto begin = std::ranges::find(nodes, i, [](const auto& node) { return node.id; });
+        return {};
+    }
+
+    const auto nodesById = indexNodesById(nodes, order);
 
-        for (auto vertex : adjacencyList[i])
+    auto edges = std::vector<Graph::EdgeData> {};
+    edges.reserve(edgeList.size());
+
+    for (const auto& [from, to] : edgeList)
+    {
+        if (from == 0 || to == 0)
         {
-            const auto end = std::ranges::find(nodes, vertex, [](const auto& node) { return node.id; });
+            return {};
+        }
+
+        const auto* const begin = nodesById[from - 1];
+        const auto* const end = nodesById[to - 1];
 
-            if (begin != nodes.end() && end != nodes.end())
-            {
-                result.addEdge({{i, vertex}, distanceFunction(*begin, *end)});
-            }
+        if (begin != nullptr && end != nullptr)
+        {
+            edges.push_back({{from - 1, to - 1}, distanceFunction(*begin, *end)});
         }
     }
 
-    return result;
+    return Graph::fromEdges(std::move(edges), order);
 }
 
-auto makeEdgeList(const std::vector<int32_t>& edgeData) -> std::optional<std::vector<Graph::Edge>>;
+/**
+ * Pairs of node numbers, terminated by -1
+ */
+auto makeEdgeList(const utils::AlignedVector<int32_t>& edgeData) -> std::optional<std::vector<Graph::Edge>>;
 
-auto makeAdjacencyList(const std::vector<int32_t>& edgeData) -> std::optional<std::vector<std::vector<Graph::Vertex>>>;
+/**
+ * Each list starts with its node followed by the adjacent ones and ends with -1, the section ends with another -1.
+ * Returns the pairs of node numbers from the head of a list to each of its adjacent nodes.
+ */
+auto makeAdjacencyList(const utils::AlignedVector<int32_t>& edgeData) -> std::optional<std::vector<Graph::Edge>>;
 
 }
 
-auto makeGraphFromEdgeData(const std::vector<int32_t>& edgeData,
+auto makeGraphFromEdgeData(const utils::AlignedVector<int32_t>& edgeData,
                            EdgeDataFormat format,
                            std::ranges::range auto&& nodes,
-                           DistanceFunction auto distanceFunction) -> std::optional<Graph>
+                           DistanceFunction auto distanceFunction,
+                           std::optional<size_t> dimension) -> std::optional<Graph>
 {
+    auto edgeList = std::optional<std::vector<Graph::Edge>> {};
+
     switch (format)
     {
     case EdgeDataFormat::EDGE_LIST:
-    {
-        auto edgeList = detail::makeEdgeList(edgeData);
-        if (edgeList)
-        {
-            return detail::makeGraphFromEdgeList(edgeList.value(),
-                                                 std::forward<decltype(nodes)>(nodes),
-                                                 distanceFunction);
-        }
-        else
-        {
-            return {};
-        }
-    }
+        edgeList = detail::makeEdgeList(edgeData);
+        break;
     case EdgeDataFormat::ADJ_LIST:
-    {
-        auto adjacencyList = detail::makeAdjacencyList(edgeData);
-        if (adjacencyList)
-        {
-            return detail::makeGraphFromAdjacencyList(adjacencyList.value(),
-                                                      std::forward<decltype(nodes)>(nodes),
-                                                      distanceFunction);
-        }
-        else
-        {
-            return {};
-        }
-    }
+        edgeList = detail::makeAdjacencyList(edgeData);
+        break;
     default:
         return {};
     }
+
+    if (!edgeList)
+    {
+        return {};
+    }
+
+    return detail::makeGraphFromEdgeList(edgeList.value(),
+                                         std::forward<decltype(nodes)>(nodes),
+                                         distanceFunction,
+                                         dimension);
 }
 
 }
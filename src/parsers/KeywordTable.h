@@ -0,0 +1,135 @@
+#pragma once
+
+#include "Parser.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace tsplib
+{
+
+template<typename T>
+struct Keyword
+{
+    std::string_view name;
+    T value;
+};
+
+namespace detail
+{
+
+constexpr auto keywordHash(std::string_view keyword, uint32_t seed) -> uint32_t
+{
+    auto hash = uint32_t {2166136261} ^ seed;
+
+    for (const auto symbol : keyword)
+    {
+        hash ^= static_cast<uint8_t>(symbol);
+        hash *= uint32_t {16777619};
+    }
+
+    return hash;
+}
+
+}
+
+/**
+ * Perfect hash over a fixed set of keywords. The seed is searched for at compile time,
+ * so a lookup costs one hash of the word and a single comparison.
+ */
+template<typename T, size_t N>
+class KeywordTable
+{
+public:
+    consteval explicit KeywordTable(const std::array<Keyword<T>, N>& keywords)
+    {
+        for (auto candidate = uint32_t {}; candidate < maxSeed; candidate++)
+        {
+            if (isCollisionFree(keywords, candidate))
+            {
+                seed = candidate;
+                perfect = true;
+                break;
+            }
+        }
+
+        for (const auto& keyword : keywords)
+        {
+            slots[slotOf(keyword.name, seed)] = keyword;
+        }
+    }
+
+    [[nodiscard]]
+    constexpr auto find(std::string_view word) const -> std::optional<T>
+    {
+        const auto& slot = slots[slotOf(word, seed)];
+
+        if (word.empty() || slot.name != word)
+        {
+            return {};
+        }
+
+        return slot.value;
+    }
+
+    [[nodiscard]]
+    constexpr auto isPerfect() const -> bool
+    {
+        return perfect;
+    }
+
+private:
+    static constexpr auto size = std::bit_ceil(2 * N);
+    static constexpr auto maxSeed = uint32_t {1} << 16;
+
+    static constexpr auto slotOf(std::string_view word, uint32_t seed) -> size_t
+    {
+        return detail::keywordHash(word, seed) & (size - 1);
+    }
+
+    static constexpr auto isCollisionFree(const std::array<Keyword<T>, N>& keywords, uint32_t seed) -> bool
+    {
+        auto isTaken = std::array<bool, size> {};
+
+        for (const auto& keyword : keywords)
+        {
+            const auto slot = slotOf(keyword.name, seed);
+            if (isTaken[slot])
+            {
+                return false;
+            }
+            isTaken[slot] = true;
+        }
+
+        return true;
+    }
+
+    std::array<Keyword<T>, size> slots {};
+    uint32_t seed {};
+    bool perfect {};
+};
+
+/**
+ * Reads a whitespace delimited word and looks it up, no characters are copied
+ */
+template<typename T, size_t N>
+constexpr auto keyword(const KeywordTable<T, N>& table)
+{
+    return [&table](std::string_view input) -> fp::Result<T> {
+        const auto size = std::min(input.find_first_of(" \t\n\v\f\r"), input.size());
+        const auto value = table.find(input.substr(0, size));
+
+        if (!value)
+        {
+            return {};
+        }
+
+        return {{*value, input.substr(size)}};
+    };
+}
+
+}
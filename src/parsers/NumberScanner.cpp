@@ -0,0 +1,534 @@
+#include "NumberScanner.h"
+#include "StatsCollector.h"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <thread>
+
+#ifdef TSPLIB_AVX2_DISPATCH
+#include <immintrin.h>
+#endif
+
+namespace tsplib
+{
+
+namespace
+{
+
+/**
+ * Smaller inputs are not worth starting threads for
+ */
+constexpr auto MIN_CHUNK_SIZE = size_t {1} << 20;
+
+auto skipWhitespaces(const char* position, const char* end) -> const char*
+{
+    while (position != end && charClassOf(*position) == CharClass::WHITESPACE)
+    {
+        position++;
+    }
+    return position;
+}
+
+/**
+ * Output of the first pass of the parallel scan, which only finds out where the numbers of every chunk go
+ */
+struct NumberCounter
+{
+    size_t count = 0;
+
+    auto push_back(auto) -> void
+    {
+        count++;
+    }
+};
+
+/**
+ * Output of the second pass of the parallel scan, the slice of the chunk is known to be large enough
+ */
+template<typename T>
+struct SliceWriter
+{
+    T* position;
+
+    auto push_back(T value) -> void
+    {
+        *position++ = value;
+    }
+};
+
+/**
+ * Stores integers in 16 bits, those which do not fit below the largest 16 bit integer become the largest one
+ */
+template<typename Output>
+struct SaturatingOutput
+{
+    Output& output;
+
+    auto push_back(int32_t value) -> void
+    {
+        static constexpr auto lowest = std::numeric_limits<int16_t>::lowest();
+        static constexpr auto largest = std::numeric_limits<int16_t>::max();
+
+        output.push_back(value >= lowest && value < largest ? static_cast<int16_t>(value) : largest);
+    }
+};
+
+/**
+ * Converts a single token starting at the given position. Returns nullptr if it is not an integer.
+ */
+template<typename Output>
+auto appendToken(const char* token, const char* end, Output& output) -> const char*
+{
+    if (token == end || charClassOf(*token) == CharClass::OTHER)
+    {
+        return nullptr;
+    }
+
+    auto value = int32_t {};
+    const auto [next, code] = std::from_chars(token, end, value);
+
+    if (code != std::errc {})
+    {
+        return nullptr;
+    }
+
+    output.push_back(value);
+    return next;
+}
+
+auto skipDigits(const char* position, const char* end) -> const char*
+{
+    while (position != end && charClassOf(*position) == CharClass::DIGIT)
+    {
+        position++;
+    }
+    return position;
+}
+
+template<typename Output>
+auto scanScalar(const char* position, const char* end, Output& output) -> const char*
+{
+    while (const auto* next = appendToken(skipWhitespaces(position, end), end, output))
+    {
+        position = next;
+    }
+
+    return position;
+}
+
+#ifdef TSPLIB_AVX2_DISPATCH
+
+/**
+ * Converts 8 ASCII digits, the most significant one in the lowest byte
+ */
+auto parseEightDigits(uint64_t digits) -> uint32_t
+{
+    static constexpr auto mask = uint64_t {0x000000FF000000FF};
+    static constexpr auto mul1 = uint64_t {0x000F424000000064};
+    static constexpr auto mul2 = uint64_t {0x0000271000000001};
+
+    digits -= 0x3030303030303030;
+    digits = (digits * 10) + (digits >> 8);
+    digits = (((digits & mask) * mul1) + (((digits >> 16) & mask) * mul2)) >> 32;
+
+    return static_cast<uint32_t>(digits);
+}
+
+template<typename Output>
+__attribute__((target("avx2")))
+auto scanAvx2(const char* begin, const char* end, Output& output) -> const char*
+{
+    static constexpr auto windowSize = uint32_t {32};
+    static constexpr auto maxSwarDigits = uint32_t {8};
+
+    const auto space = _mm256_set1_epi8(' ');
+    const auto tab = _mm256_set1_epi8('\t');
+    const auto zero = _mm256_set1_epi8('0');
+    const auto minus = _mm256_set1_epi8('-');
+    const auto four = _mm256_set1_epi8(4);
+    const auto nine = _mm256_set1_epi8(9);
+
+    // Position right after the last scanned integer
+    const auto* last = begin;
+    // Beginning of the current 32 byte window, only whitespaces can be between last and window
+    const auto* window = begin;
+
+    while (end - window >= static_cast<std::ptrdiff_t>(windowSize))
+    {
+        const auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(window));
+
+        // '\t', '\n', '\v', '\f', '\r' are consecutive, so one unsigned range check covers them
+        const auto controlOffset = _mm256_sub_epi8(chunk, tab);
+        const auto isControlSpace = _mm256_cmpeq_epi8(_mm256_min_epu8(controlOffset, four), controlOffset);
+        const auto isWhitespace = _mm256_or_si256(isControlSpace, _mm256_cmpeq_epi8(chunk, space));
+
+        const auto digitOffset = _mm256_sub_epi8(chunk, zero);
+        const auto isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digitOffset, nine), digitOffset);
+
+        const auto whitespaceMask = static_cast<uint32_t>(_mm256_movemask_epi8(isWhitespace));
+        const auto digitMask = static_cast<uint32_t>(_mm256_movemask_epi8(isDigit));
+        const auto minusMask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, minus)));
+
+        auto offset = uint32_t {};
+        const auto* nextWindow = window + windowSize;
+
+        while (true)
+        {
+            const auto tokenBits = ~whitespaceMask & (~uint32_t {} << offset);
+            if (tokenBits == 0)
+            {
+                break;
+            }
+
+            const auto tokenStart = static_cast<uint32_t>(std::countr_zero(tokenBits));
+            const auto tokenEndBits = whitespaceMask & (~uint32_t {} << tokenStart);
+
+            if (tokenEndBits == 0 && tokenStart != 0)
+            {
+                // The token crosses the window boundary, so it is scanned again from its beginning
+                nextWindow = window + tokenStart;
+                break;
+            }
+
+            const auto tokenEnd = tokenEndBits == 0
+                                  ? windowSize
+                                  : static_cast<uint32_t>(std::countr_zero(tokenEndBits));
+            const auto isNegative = (minusMask >> tokenStart) & 1;
+            const auto digitsStart = tokenStart + isNegative;
+            const auto digitsCount = tokenEnd - digitsStart;
+
+            if (tokenEndBits != 0 && digitsCount != 0 && digitsCount <= maxSwarDigits &&
+                static_cast<std::ptrdiff_t>(tokenEnd) + (window - begin) >= static_cast<std::ptrdiff_t>(maxSwarDigits))
+            {
+                const auto digitsBits = ((uint32_t {1} << digitsCount) - 1) << digitsStart;
+
+                if ((digitMask & digitsBits) == digitsBits)
+                {
+                    auto digits = uint64_t {};
+                    std::memcpy(&digits, window + tokenEnd - maxSwarDigits, sizeof(digits));
+
+                    // Bytes in front of the digits are replaced by leading zeros
+                    const auto paddingBits = (maxSwarDigits - digitsCount) * 8;
+                    const auto paddingMask = paddingBits == 0 ? uint64_t {} : (uint64_t {1} << paddingBits) - 1;
+                    digits = (digits & ~paddingMask) | (uint64_t {0x3030303030303030} & paddingMask);
+
+                    const auto value = static_cast<int32_t>(parseEightDigits(digits));
+                    output.push_back(isNegative ? -value : value);
+
+                    last = window + tokenEnd;
+                    offset = tokenEnd;
+                    continue;
+                }
+            }
+
+            // Anything unusual (long numbers, trailing garbage, keywords) is left to std::from_chars
+            const auto* next = appendToken(window + tokenStart, end, output);
+            if (next == nullptr)
+            {
+                return last;
+            }
+
+            last = next;
+            nextWindow = next;
+            break;
+        }
+
+        window = nextWindow;
+    }
+
+    return scanScalar(last, end, output);
+}
+
+#endif
+
+template<typename Output>
+auto scan(const char* begin, const char* end, Output& output) -> const char*
+{
+#ifdef TSPLIB_AVX2_DISPATCH
+    if (detail::isAvx2Supported())
+    {
+        return scanAvx2(begin, end, output);
+    }
+#endif
+    return scanScalar(begin, end, output);
+}
+
+template<typename Output>
+auto scanSaturating(const char* begin, const char* end, Output& output) -> const char*
+{
+    auto saturating = SaturatingOutput<Output> {output};
+    return scan(begin, end, saturating);
+}
+
+template<typename Output>
+auto scanReals(const char* position, const char* end, Output& output) -> const char*
+{
+    while (const auto value = real({skipWhitespaces(position, end), end}))
+    {
+        output.push_back(static_cast<float>(value->first));
+        position = value->second.data();
+    }
+
+    return position;
+}
+
+auto isBlank(std::string_view input) -> bool
+{
+    return std::ranges::all_of(input, [](auto symbol) { return charClassOf(symbol) == CharClass::WHITESPACE; });
+}
+
+/**
+ * See detail::integersParallel, the chunks are scanned by scanChunk(begin, end, output) into any output
+ */
+template<typename T, typename ScanChunk>
+auto scanParallel(std::string_view input,
+                  uint32_t threads,
+                  size_t minChunkSize,
+                  utils::AlignedVector<T>& output,
+                  const ScanChunk& scanChunk) -> std::string_view
+{
+    const auto chunksCount = std::clamp<size_t>(input.size() / std::max<size_t>(minChunkSize, 1), 1, threads);
+
+    // Chunks end at whitespaces, so no token is split. Chunks past the end of the section are scanned as well,
+    // what they find is dropped since the sequential scan would never get there.
+    auto boundaries = std::vector<size_t> {0};
+    for (auto i = size_t {1}; i < chunksCount; i++)
+    {
+        auto boundary = std::max(input.size() * i / chunksCount, boundaries.back());
+        while (boundary < input.size() && charClassOf(input[boundary]) != CharClass::WHITESPACE)
+        {
+            boundary++;
+        }
+        boundaries.push_back(boundary);
+    }
+    boundaries.push_back(input.size());
+
+    const auto chunkOf = [&input, &boundaries](size_t i) {
+        return input.substr(boundaries[i], boundaries[i + 1] - boundaries[i]);
+    };
+
+    auto* const allocationCounters = currentAllocationCounters();
+    const auto runOnChunks = [allocationCounters](size_t count, const auto& work) {
+        auto workers = std::vector<std::jthread> {};
+        workers.reserve(count - 1);
+
+        for (auto i = size_t {1}; i < count; i++)
+        {
+            workers.emplace_back([&work, allocationCounters, i] {
+                [[maybe_unused]] const auto allocationScope = WorkerAllocationScope {allocationCounters};
+                work(i);
+            });
+        }
+
+        work(0);
+    };
+
+    auto counts = std::vector<size_t>(chunksCount);
+    auto rests = std::vector<std::string_view>(chunksCount);
+
+    runOnChunks(chunksCount, [&](size_t i) {
+        const auto chunk = chunkOf(i);
+        auto counter = NumberCounter {};
+        const auto* const rest = scanChunk(chunk.data(), chunk.data() + chunk.size(), counter);
+
+        counts[i] = counter.count;
+        rests[i] = chunk.substr(static_cast<size_t>(rest - chunk.data()));
+    });
+
+    // The sequential scan stops in the first chunk which does not end with numbers
+    auto offsets = std::vector<size_t> {output.size()};
+    auto rest = input;
+
+    for (auto i = size_t {}; i < chunksCount; i++)
+    {
+        offsets.push_back(offsets.back() + counts[i]);
+
+        if (counts[i] != 0)
+        {
+            rest = input.substr(static_cast<size_t>(rests[i].data() - input.data()));
+        }
+
+        if (!isBlank(rests[i]))
+        {
+            break;
+        }
+    }
+
+    const auto usedChunks = offsets.size() - 1;
+    output.resize(offsets.back());
+
+    runOnChunks(usedChunks, [&](size_t i) {
+        const auto chunk = chunkOf(i);
+        auto writer = SliceWriter<T> {output.data() + offsets[i]};
+        static_cast<void>(scanChunk(chunk.data(), chunk.data() + chunk.size(), writer));
+    });
+
+    return rest;
+}
+
+/**
+ * Scans chunk by chunk on the threads if the input is large enough to be split
+ */
+template<typename T, typename ScanChunk>
+auto scanOnThreads(std::string_view input, utils::AlignedVector<T>& output, uint32_t threads, const ScanChunk& scanChunk)
+    -> std::string_view
+{
+    if (threads > 1 && input.size() >= 2 * MIN_CHUNK_SIZE)
+    {
+        return scanParallel(input, threads, MIN_CHUNK_SIZE, output, scanChunk);
+    }
+
+    const auto* const end = input.data() + input.size();
+    const auto* const rest = scanChunk(input.data(), end, output);
+
+    return {rest, static_cast<size_t>(end - rest)};
+}
+
+}
+
+namespace detail
+{
+
+auto appendIntegersScalar(std::string_view input, utils::AlignedVector<int32_t>& output) -> std::string_view
+{
+    const auto* const end = input.data() + input.size();
+    const auto* const rest = scanScalar(input.data(), end, output);
+
+    return {rest, static_cast<size_t>(end - rest)};
+}
+
+#ifdef TSPLIB_AVX2_DISPATCH
+
+auto appendIntegersAvx2(std::string_view input, utils::AlignedVector<int32_t>& output) -> std::string_view
+{
+    const auto* const end = input.data() + input.size();
+    const auto* const rest = scanAvx2(input.data(), end, output);
+
+    return {rest, static_cast<size_t>(end - rest)};
+}
+
+#endif
+
+auto integersParallel(std::string_view input, uint32_t threads, size_t minChunkSize, utils::AlignedVector<int32_t>& output)
+    -> std::string_view
+{
+    return scanParallel(input, threads, minChunkSize, output, [](const char* begin, const char* end, auto& chunkOutput) {
+        return scan(begin, end, chunkOutput);
+    });
+}
+
+auto isAvx2Supported() -> bool
+{
+    return utils::isAvx2Supported();
+}
+
+}
+
+auto appendIntegers(std::string_view input, utils::AlignedVector<int32_t>& output) -> std::string_view
+{
+#ifdef TSPLIB_AVX2_DISPATCH
+    if (detail::isAvx2Supported())
+    {
+        return detail::appendIntegersAvx2(input, output);
+    }
+#endif
+    return detail::appendIntegersScalar(input, output);
+}
+
+auto appendIntegers(std::string_view input, utils::AlignedVector<int32_t>& output, uint32_t threads) -> std::string_view
+{
+    if (threads > 1 && input.size() >= 2 * MIN_CHUNK_SIZE)
+    {
+        return detail::integersParallel(input, threads, MIN_CHUNK_SIZE, output);
+    }
+
+    return appendIntegers(input, output);
+}
+
+auto appendIntegers(std::string_view input, utils::AlignedVector<int16_t>& output, uint32_t threads) -> std::string_view
+{
+    return scanOnThreads(input, output, threads, [](const char* begin, const char* end, auto& chunkOutput) {
+        return scanSaturating(begin, end, chunkOutput);
+    });
+}
+
+auto appendReals(std::string_view input, utils::AlignedVector<float>& output, uint32_t threads) -> std::string_view
+{
+    return scanOnThreads(input, output, threads, [](const char* begin, const char* end, auto& chunkOutput) {
+        return scanReals(begin, end, chunkOutput);
+    });
+}
+
+auto integers(std::string_view input, uint32_t threads, size_t expectedCount) -> fp::Result<utils::AlignedVector<int32_t>>
+{
+    auto result = utils::AlignedVector<int32_t> {};
+    // Guards against a bogus expected count, the input cannot hold more integers than characters
+    result.reserve(std::min(expectedCount, input.size()));
+    const auto rest = appendIntegers(input, result, threads);
+
+    if (result.empty())
+    {
+        return {};
+    }
+
+    return {{std::move(result), rest}};
+}
+
+auto real(std::string_view input) -> fp::Result<double>
+{
+    const auto* const end = input.data() + input.size();
+    const auto* position = input.data();
+
+    if (position != end && (*position == '-' || *position == '+'))
+    {
+        position++;
+    }
+
+    // std::from_chars does not accept an explicit plus sign
+    const auto* const numberStart = input.data() + (input.starts_with('+') ? 1 : 0);
+    const auto* const integralEnd = skipDigits(position, end);
+    auto digitsCount = integralEnd - position;
+    position = integralEnd;
+
+    if (position != end && *position == '.')
+    {
+        const auto* const fractionEnd = skipDigits(position + 1, end);
+        digitsCount += fractionEnd - position - 1;
+        position = fractionEnd;
+    }
+
+    if (digitsCount == 0)
+    {
+        return {};
+    }
+
+    if (position != end && (*position == 'e' || *position == 'E'))
+    {
+        const auto* exponent = position + 1;
+        if (exponent != end && (*exponent == '-' || *exponent == '+'))
+        {
+            exponent++;
+        }
+
+        // The exponent is a part of the number only if it has digits
+        const auto* const exponentEnd = skipDigits(exponent, end);
+        if (exponentEnd != exponent)
+        {
+            position = exponentEnd;
+        }
+    }
+
+    const auto value = utils::stringToNumber<double>({numberStart, static_cast<size_t>(position - numberStart)});
+
+    if (!value)
+    {
+        return {};
+    }
+
+    return {{*value, input.substr(static_cast<size_t>(position - input.data()))}};
+}
+
+}
\ No newline at end of file
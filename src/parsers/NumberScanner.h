@@ -0,0 +1,119 @@
+#pragma once
+
+#include "Parser.h"
+#include "utils/AlignedAllocator.h"
+#include "utils/Simd.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace tsplib
+{
+
+enum class CharClass : uint8_t
+{
+    OTHER,
+    DIGIT,
+    MINUS,
+    WHITESPACE
+};
+
+namespace detail
+{
+
+constexpr auto makeCharClassTable() -> std::array<CharClass, 256>
+{
+    auto table = std::array<CharClass, 256> {};
+
+    for (auto symbol = '0'; symbol <= '9'; symbol++)
+    {
+        table[static_cast<unsigned char>(symbol)] = CharClass::DIGIT;
+    }
+
+    table[static_cast<unsigned char>('-')] = CharClass::MINUS;
+
+    for (const auto symbol : {' ', '\t', '\n', '\v', '\f', '\r'})
+    {
+        table[static_cast<unsigned char>(symbol)] = CharClass::WHITESPACE;
+    }
+
+    return table;
+}
+
+auto appendIntegersScalar(std::string_view input, utils::AlignedVector<int32_t>& output) -> std::string_view;
+
+#ifdef TSPLIB_AVX2_DISPATCH
+
+/**
+ * Finds token boundaries 32 bytes at a time and converts runs of up to 8 digits with SWAR arithmetic.
+ * Every other token goes through std::from_chars, so the result is identical to the scalar tokenizer.
+ * Must be called only if isAvx2Supported() returns true.
+ */
+auto appendIntegersAvx2(std::string_view input, utils::AlignedVector<int32_t>& output) -> std::string_view;
+
+#endif
+
+[[nodiscard]]
+auto isAvx2Supported() -> bool;
+
+/**
+ * Splits the input at whitespaces into chunks of at least minChunkSize bytes and scans them on separate threads
+ * twice. The first pass counts the integers of every chunk, the output is resized once, and the second pass
+ * writes every chunk to its own slice of it. Appends and returns the same as the sequential appendIntegers.
+ */
+auto integersParallel(std::string_view input, uint32_t threads, size_t minChunkSize, utils::AlignedVector<int32_t>& output)
+    -> std::string_view;
+
+}
+
+inline constexpr auto charClassTable = detail::makeCharClassTable();
+
+[[nodiscard]]
+constexpr auto charClassOf(char symbol) -> CharClass
+{
+    return charClassTable[static_cast<unsigned char>(symbol)];
+}
+
+/**
+ * Appends whitespace separated integers from the beginning of the input to the output,
+ * stopping in front of the first token which is not an integer (e.g. the next keyword).
+ * Returns the input remaining right after the last scanned integer.
+ *
+ * Uses the AVX2 tokenizer when the CPU supports it and the scalar one otherwise.
+ */
+auto appendIntegers(std::string_view input, utils::AlignedVector<int32_t>& output) -> std::string_view;
+
+/**
+ * Same as above, but large inputs are scanned on the given number of threads
+ */
+auto appendIntegers(std::string_view input, utils::AlignedVector<int32_t>& output, uint32_t threads) -> std::string_view;
+
+/**
+ * Same as above, but the integers are stored in 16 bits. Those which do not fit below the largest 16 bit integer
+ * are stored as the largest one, which is INFINITY_WEIGHT of 16 bit graphs, so a caller can tell they did not fit.
+ */
+auto appendIntegers(std::string_view input, utils::AlignedVector<int16_t>& output, uint32_t threads) -> std::string_view;
+
+/**
+ * Appends whitespace separated reals as read by real, rounded to float, and stops the same as appendIntegers.
+ * Large inputs are scanned on the given number of threads.
+ */
+auto appendReals(std::string_view input, utils::AlignedVector<float>& output, uint32_t threads) -> std::string_view;
+
+/**
+ * Equivalent of fp::some(fp::tokenLeft(fp::integer<int32_t>)) which does not build any intermediate strings.
+ * Large inputs are scanned on the given number of threads. The result reserves expectedCount elements,
+ * but never more than the input has characters.
+ */
+[[nodiscard]]
+auto integers(std::string_view input, uint32_t threads = 1, size_t expectedCount = 0) -> fp::Result<utils::AlignedVector<int32_t>>;
+
+/**
+ * Reads a decimal number with an optional sign, fraction and exponent from the very beginning
+ * of the input, e.g. "-12", "3.5", ".25" or "1.5e+06". Nothing is copied.
+ */
+[[nodiscard]]
+auto real(std::string_view input) -> fp::Result<double>;
+
+}
\ No newline at end of file
@@ -1,8 +1,30 @@
 #include "Reader.h"
+#include "StreamParser.h"
 
 #ifdef NDEBUG
-#include "SubParsers.h"
 #include "GraphParser.h"
+#include "NumberScanner.h"
+#include "StatsCollector.h"
+#include "io/BinaryCache.h"
+#include "io/FileInput.h"
+#include "io/GzipInput.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include <thread>
+
+#if __has_include(<sys/stat.h>) && __has_include(<unistd.h>)
+#define TSPLIB_HAS_USER_CACHE
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 #endif
 
 namespace tsplib
@@ -10,64 +32,468 @@ namespace tsplib
 
 #ifdef NDEBUG
 
-auto getGraphFromConfig(const Config& config) -> std::optional<Graph>;
-auto getTypeFromConfig(const Config& config) -> std::optional<Type>;
+auto getContentFromFileBytes(std::string_view bytes, const ParseOptions& options) -> std::optional<Content>;
+auto getContentFromGzip(std::string_view compressed, const ParseOptions& options) -> std::optional<Content>;
+auto getContentFromConfig(Config config, ParseStats* stats = nullptr) -> std::optional<Content>;
+auto getGraphFromConfig(Config& config, ParseStats* stats) -> std::optional<Graph>;
+auto getCoordinatesFromConfig(const Config& config) -> std::optional<Coordinates>;
+auto getMetaDataFromSpecification(const Specification& specification) -> MetaData;
+auto getTypeFromSpecification(const Specification& specification) -> std::optional<Type>;
+template<GraphWeight W>
+auto scanWeights(std::string_view input, const Specification& specification, const ParseOptions& options)
+    -> std::optional<utils::AlignedVector<W>>;
 
 auto canGraphBeMadeFromEdgeData(const Config& config) -> bool;
 auto canGraphBeMadeFromWeights(const Config& config) -> bool;
 
-auto getTspContent(std::string_view input) -> std::optional<Content>
+auto getUserCacheDirectory() -> std::optional<std::filesystem::path>;
+auto getCachePaths(const std::filesystem::path& path, uint64_t sourceHash) -> std::vector<std::filesystem::path>;
+
+auto getTspContent(std::string_view input, const ParseOptions& options) -> std::optional<Content>
 {
-    const auto data = tspData(input);
+    [[maybe_unused]] const auto allocationScope = AllocationScope {options.stats};
+    const auto timer = StageTimer {options.stats, &ParseStats::total};
+
+    updateStats(options.stats, [input](auto& stats) { stats.bytes += input.size(); });
+
+    auto data = tspData(input, options);
 
     if (!data)
     {
         return {};
     }
 
-    const auto config = data->first;
-    const auto graph = getGraphFromConfig(config);
+    return getContentFromConfig(std::move(data->first), options.stats);
+}
+
+/**
+ * The specification and every other section are parsed from the offsets specificationIndex finds,
+ * only the weights are scanned into the weight type
+ */
+template<GraphWeight W>
+auto getTspContentAs(std::string_view input, const ParseOptions& options) -> std::optional<BasicContent<W>>
+{
+    if constexpr (std::same_as<W, Graph::Weight>)
+    {
+        return getTspContent(input, options);
+    }
+    else
+    {
+        [[maybe_unused]] const auto allocationScope = AllocationScope {options.stats};
+        const auto timer = StageTimer {options.stats, &ParseStats::total};
+
+        updateStats(options.stats, [input](auto& stats) { stats.bytes += input.size(); });
+
+        auto index = specificationIndex(input);
+
+        if (!index)
+        {
+            return {};
+        }
+
+        auto data = TspData {};
+        auto weights = std::optional<utils::AlignedVector<W>> {};
+        {
+            const auto tokenizingTimer = StageTimer {options.stats, &ParseStats::tokenizing};
+
+            for (const auto& section : index->sections)
+            {
+                const auto sectionInput = input.substr(section.offset);
+
+                if (section.tag == EDGE_WEIGHT_SECTION)
+                {
+                    weights = scanWeights<W>(fp::tokenLeft(tag)(sectionInput)->second, index->specification, options);
+                }
+                else if (auto item = tspItem(sectionInput, options))
+                {
+                    updateStats(options.stats, [&item](auto& stats) { stats.tokens += countTokens(item->first); });
+                    data.data.push_back(std::move(item->first));
+                }
+            }
+        }
+
+        auto config = Config {};
+        {
+            const auto filteringTimer = StageTimer {options.stats, &ParseStats::filtering};
+            config = std::move(data).filtered();
+            config.specification = std::move(index->specification);
+        }
+
+        auto graph = std::optional<BasicGraph<W>> {};
+        {
+            const auto graphTimer = StageTimer {options.stats, &ParseStats::graphBuilding};
+
+            if (canGraphBeMadeFromEdgeData(config))
+            {
+                if (const auto wideGraph = getGraphFromConfig(config, options.stats))
+                {
+                    graph = convertGraph<W>(wideGraph.value());
+                }
+            }
+            else if (weights && config.specification.edgeWeightFormat)
+            {
+                graph = makeGraphFromWeights(std::move(weights).value(),
+                                             config.specification.edgeWeightFormat.value(),
+                                             config.specification.dimension,
+                                             config.specification.type == AlgorithmType::TSP);
+
+                // A weight which did not fit was stored as INFINITY_WEIGHT, only the diagonal may hold it
+                if constexpr (std::integral<W>)
+                {
+                    if (graph && graph->getSize() != graph->getOrder() * (graph->getOrder() - 1))
+                    {
+                        return {};
+                    }
+                }
+            }
+        }
+
+        if (!graph.has_value())
+        {
+            return {};
+        }
+
+        updateStats(options.stats, [&graph](auto& stats) { stats.representation = graph->getRepresentation(); });
+
+        return BasicContent<W> {
+            .metaData = getMetaDataFromSpecification(config.specification),
+            .graph = std::move(graph).value(),
+            .coordinates = getCoordinatesFromConfig(config)
+        };
+    }
+}
+
+auto getTspContentFromFile(const std::filesystem::path& path, const ParseOptions& options) -> std::optional<Content>
+{
+    const auto file = FileInput::open(path);
+
+    if (!file)
+    {
+        return {};
+    }
+
+    return getContentFromFileBytes(file->getContent(), options);
+}
+
+auto getTspContents(std::span<const std::filesystem::path> paths,
+                    uint32_t threads,
+                    const ParseOptions& options) -> std::vector<std::optional<Content>>
+{
+    // Longest processing time first, so a big file picked up last does not leave the other threads idle
+    auto sizes = std::vector<uintmax_t>(paths.size());
+    for (auto i = size_t {}; i < paths.size(); i++)
+    {
+        auto error = std::error_code {};
+        const auto size = std::filesystem::file_size(paths[i], error);
+        sizes[i] = error ? 0 : size;
+    }
+
+    auto order = std::vector<size_t>(paths.size());
+    std::iota(order.begin(), order.end(), size_t {});
+    std::ranges::stable_sort(order, std::greater {}, [&sizes](auto i) { return sizes[i]; });
+
+    auto contents = std::vector<std::optional<Content>>(paths.size());
+    auto next = std::atomic<size_t> {};
+
+    // The files are parsed at the same time, so they cannot share the statistics
+    auto fileOptions = options;
+    fileOptions.stats = nullptr;
+
+    // Every thread claims the next file as soon as it is done with the previous one
+    const auto work = [&] {
+        for (auto claimed = next.fetch_add(1, std::memory_order_relaxed);
+             claimed < order.size();
+             claimed = next.fetch_add(1, std::memory_order_relaxed))
+        {
+            const auto i = order[claimed];
+            contents[i] = getTspContentFromFile(paths[i], fileOptions);
+        }
+    };
+
+    const auto workersCount = std::clamp<size_t>(paths.size(), 1, std::max<uint32_t>(threads, 1));
+    {
+        auto workers = std::vector<std::jthread> {};
+        workers.reserve(workersCount - 1);
+
+        for (auto i = size_t {1}; i < workersCount; i++)
+        {
+            workers.emplace_back(work);
+        }
+
+        work();
+    }
+
+    return contents;
+}
+
+auto CachedContent::open(const std::filesystem::path& path) -> std::optional<CachedContent>
+{
+    auto file = FileInput::open(path);
+
+    if (!file)
+    {
+        return {};
+    }
+
+    auto layout = readCache(file->getContent());
+
+    if (!layout)
+    {
+        return {};
+    }
+
+    // A buffered file moves its bytes along with it, so they are located only after the move
+    const auto storage = std::make_shared<const FileInput>(std::move(file.value()));
+    const auto bytes = storage->getContent();
+
+    auto result = CachedContent {};
+    result.storage = storage;
+    result.metaData = std::move(layout->metaData);
+    result.coordinates = std::move(layout->coordinates);
+    result.representation = layout->representation;
+    result.weights = {reinterpret_cast<const Graph::Weight*>(bytes.data() + layout->weightsOffset), layout->weightsCount};
+    if (layout->representation == GraphRepresentation::SPARSE_ROWS)
+    {
+        result.columnIndices = {reinterpret_cast<const Graph::Vertex*>(bytes.data() + layout->columnsOffset),
+                                layout->weightsCount};
+        result.rowOffsets = {reinterpret_cast<const size_t*>(bytes.data() + layout->rowOffsetsOffset), layout->order + 1};
+    }
+    result.order = layout->order;
+    result.size = layout->size;
+    result.sourceHash = layout->sourceHash;
+
+    return result;
+}
+
+auto writeTspCache(const Content& content, uint64_t sourceHash, const std::filesystem::path& path) -> bool
+{
+    // Readers only ever see a complete cache, the file is written under another name and renamed
+    auto temporaryPath = path;
+    temporaryPath += ".tmp" + std::to_string(std::random_device {}());
+
+    auto error = std::error_code {};
+    {
+        auto output = std::ofstream {temporaryPath, std::ios::binary};
+
+        if (!output || !writeCache(output, content, sourceHash))
+        {
+            output.close();
+            std::filesystem::remove(temporaryPath, error);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temporaryPath, path, error);
+
+    if (error)
+    {
+        std::filesystem::remove(temporaryPath, error);
+        return false;
+    }
+
+    return true;
+}
+
+auto getTspContentCached(const std::filesystem::path& path, const ParseOptions& options) -> std::optional<CachedContent>
+{
+    const auto file = FileInput::open(path);
+
+    if (!file)
+    {
+        return {};
+    }
+
+    const auto sourceHash = contentHash(file->getContent());
+    const auto cachePaths = getCachePaths(path, sourceHash);
+
+    for (const auto& cachePath : cachePaths)
+    {
+        auto cached = CachedContent::open(cachePath);
+
+        if (cached && cached->getSourceHash() == sourceHash)
+        {
+            return cached;
+        }
+    }
+
+    const auto content = getContentFromFileBytes(file->getContent(), options);
+
+    if (!content)
+    {
+        return {};
+    }
+
+    for (const auto& cachePath : cachePaths)
+    {
+        if (writeTspCache(content.value(), sourceHash, cachePath))
+        {
+            return CachedContent::open(cachePath);
+        }
+    }
+
+    return {};
+}
+
+auto getTspHeader(std::string_view input) -> std::optional<Header>
+{
+    auto index = specificationIndex(input);
+
+    if (!index)
+    {
+        return {};
+    }
+
+    auto header = Header {
+        .metaData = getMetaDataFromSpecification(index->specification),
+        .edgeWeightType = std::move(index->edgeWeightTypeKeyword),
+        .sections = {}
+    };
+
+    header.sections.reserve(index->sections.size());
+    for (auto& section : index->sections)
+    {
+        header.sections.push_back({std::move(section.tag), section.offset});
+    }
+
+    return header;
+}
+
+auto getTspHeaderFromFile(const std::filesystem::path& path) -> std::optional<Header>
+{
+    const auto file = FileInput::open(path);
+
+    if (!file)
+    {
+        return {};
+    }
+
+    return getTspHeader(file->getContent());
+}
+
+StreamReader::StreamReader(size_t bufferSize, const ParseOptions& options)
+    : parser {std::make_unique<TspStreamParser>(bufferSize, options)}
+    , stats {options.stats}
+{
+
+}
+
+auto StreamReader::feed(std::span<const char> chunk) -> bool
+{
+    return parser->feed(chunk);
+}
+
+auto StreamReader::finish() -> std::optional<Content>
+{
+    auto config = parser->finish();
+
+    if (!config)
+    {
+        return {};
+    }
+
+    return getContentFromConfig(std::move(config.value()), stats);
+}
+
+auto getContentFromFileBytes(std::string_view bytes, const ParseOptions& options) -> std::optional<Content>
+{
+    if (isGzip(bytes))
+    {
+        return getContentFromGzip(bytes, options);
+    }
+
+    return getTspContent(bytes, options);
+}
+
+/**
+ * The decompressed text goes straight to the stream parser, it is never stored as a whole
+ */
+auto getContentFromGzip(std::string_view compressed, const ParseOptions& options) -> std::optional<Content>
+{
+    // Only a single line of text has to fit, but rows of big matrices are long.
+    // Every thread gets a chunk of the size the section parsers split at.
+    static constexpr auto bufferSizePerThread = size_t {1} << 20;
+
+    [[maybe_unused]] const auto allocationScope = AllocationScope {options.stats};
+    const auto timer = StageTimer {options.stats, &ParseStats::total};
+
+    auto reader = StreamReader {bufferSizePerThread * std::max(options.threads, uint32_t {1}), options};
+
+    if (!gunzip(compressed, [&reader](std::span<const char> chunk) { return reader.feed(chunk); }))
+    {
+        return {};
+    }
+
+    return reader.finish();
+}
+
+auto getContentFromConfig(Config config, ParseStats* stats) -> std::optional<Content>
+{
+    auto graph = std::optional<Graph> {};
+    {
+        const auto timer = StageTimer {stats, &ParseStats::graphBuilding};
+        graph = getGraphFromConfig(config, stats);
+    }
 
     if (!graph.has_value())
     {
         return {};
     }
 
+    updateStats(stats, [&graph](auto& stats) { stats.representation = graph->getRepresentation(); });
+
     auto content = Content{
-        .metaData = {
-            .name = config.specification.name,
-            .comment = config.specification.comment,
-            .type = getTypeFromConfig(config)
-        },
-        .graph = graph.value()
+        .metaData = getMetaDataFromSpecification(config.specification),
+        .graph = std::move(graph.value()),
+        .coordinates = getCoordinatesFromConfig(config)
     };
 
     return content;
 }
 
-auto getGraphFromConfig(const Config& config) -> std::optional<Graph>
+auto getMetaDataFromSpecification(const Specification& specification) -> MetaData
+{
+    return {
+        .name = specification.name,
+        .comment = specification.comment,
+        .type = getTypeFromSpecification(specification),
+        .dimension = specification.dimension
+    };
+}
+
+/**
+ * Weights are moved out of the config into the graph
+ */
+auto getGraphFromConfig(Config& config, ParseStats* stats) -> std::optional<Graph>
 {
     if (canGraphBeMadeFromEdgeData(config))
     {
+        // Timing every evaluation would read the clock twice per edge
+        const auto timer = StageTimer {stats, &ParseStats::distances};
+
         return std::visit(match{
             [&config](const Nodes2d& nodes2d) {
                 return makeGraphFromEdgeData(config.data.edgeDataSection.value(),
                                               config.specification.edgeDataFormat.value(),
                                               nodes2d.nodes2d,
-                                              getDistanceFunction(config.specification.edgeWeightType.value()));
+                                              getDistanceFunction(config.specification.edgeWeightType.value()),
+                                              config.specification.dimension);
 
             },
             [&config](const Nodes3d& nodes3d) {
                 return makeGraphFromEdgeData(config.data.edgeDataSection.value(),
                                               config.specification.edgeDataFormat.value(),
                                               nodes3d.nodes3d,
-                                              getDistanceFunction(config.specification.edgeWeightType.value()));
+                                              getDistanceFunction(config.specification.edgeWeightType.value()),
+                                              config.specification.dimension);
             },
         }, config.data.nodeCoordSection.value());
     }
     else if (canGraphBeMadeFromWeights(config))
     {
-        return makeGraphFromWeights(config.data.edgeWeightSection.value(), config.specification.edgeWeightFormat.value());
+        return makeGraphFromWeights(std::move(config.data.edgeWeightSection.value()),
+                                    config.specification.edgeWeightFormat.value(),
+                                    config.specification.dimension,
+                                    config.specification.type == AlgorithmType::TSP);
     }
     else
     {
@@ -75,14 +501,78 @@ auto getGraphFromConfig(const Config& config) -> std::optional<Graph>
     }
 }
 
-auto getTypeFromConfig(const Config& config) -> std::optional<Type>
+/**
+ * Room is reserved as tspData reserves it for 32 bit weights. Nothing if the section has no weights.
+ */
+template<GraphWeight W>
+auto scanWeights(std::string_view input, const Specification& specification, const ParseOptions& options)
+    -> std::optional<utils::AlignedVector<W>>
 {
-    if (!config.specification.type)
+    auto weights = utils::AlignedVector<W> {};
+
+    if (specification.dimension)
+    {
+        const auto format = specification.edgeWeightFormat.value_or(EdgeWeightFormat::FULL_MATRIX);
+        // Guards against a bogus dimension, the input cannot hold more weights than characters
+        weights.reserve(std::min(getWeightsCapacity<W>(format, specification.dimension.value()), input.size()));
+    }
+
+    if constexpr (std::floating_point<W>)
+    {
+        static_cast<void>(appendReals(input, weights, options.threads));
+    }
+    else
+    {
+        static_cast<void>(appendIntegers(input, weights, options.threads));
+    }
+
+    if (weights.empty())
+    {
+        return {};
+    }
+
+    updateStats(options.stats, [&weights](auto& stats) { stats.tokens += weights.size(); });
+
+    return weights;
+}
+
+auto getCoordinatesFromConfig(const Config& config) -> std::optional<Coordinates>
+{
+    if (!config.data.nodeCoordSection)
+    {
+        return {};
+    }
+
+    return std::visit(match{
+        [](const Nodes2d& nodes2d) -> Coordinates {
+            auto points = std::vector<Point2d> {};
+            points.reserve(nodes2d.nodes2d.size());
+            for (const auto& node : nodes2d.nodes2d)
+            {
+                points.push_back({node.id, node.x, node.y});
+            }
+            return points;
+        },
+        [](const Nodes3d& nodes3d) -> Coordinates {
+            auto points = std::vector<Point3d> {};
+            points.reserve(nodes3d.nodes3d.size());
+            for (const auto& node : nodes3d.nodes3d)
+            {
+                points.push_back({node.id, node.x, node.y, node.z});
+            }
+            return points;
+        },
+    }, config.data.nodeCoordSection.value());
+}
+
+auto getTypeFromSpecification(const Specification& specification) -> std::optional<Type>
+{
+    if (!specification.type)
     {
         return {};
     }
 
-    switch (config.specification.type.value())
+    switch (specification.type.value())
     {
     case AlgorithmType::TSP:
         return Type::TSP;
@@ -115,12 +605,272 @@ auto canGraphBeMadeFromWeights(const Config& config) -> bool
     return config.data.edgeWeightSection.has_value() && config.specification.edgeWeightFormat.has_value();
 }
 
+/**
+ * $XDG_CACHE_HOME/tsplib or ~/.cache/tsplib, created private to the user. Nothing if it is not a directory
+ * which only the user owns and can write to, since anyone else could plant caches in it.
+ */
+auto getUserCacheDirectory() -> std::optional<std::filesystem::path>
+{
+#ifdef TSPLIB_HAS_USER_CACHE
+    auto base = std::filesystem::path {};
+
+    // Relative paths are ignored as the XDG specification asks
+    if (const auto* const cacheHome = std::getenv("XDG_CACHE_HOME"); cacheHome != nullptr && cacheHome[0] == '/')
+    {
+        base = cacheHome;
+    }
+    else if (const auto* const home = std::getenv("HOME"); home != nullptr && home[0] == '/')
+    {
+        base = std::filesystem::path {home} / ".cache";
+    }
+    else
+    {
+        return {};
+    }
+
+    auto error = std::error_code {};
+    std::filesystem::create_directories(base, error);
+
+    auto directory = base / "tsplib";
+    if (::mkdir(directory.c_str(), S_IRWXU) != 0 && errno != EEXIST)
+    {
+        return {};
+    }
+
+    struct stat status {};
+    if (::lstat(directory.c_str(), &status) != 0 || !S_ISDIR(status.st_mode) || status.st_uid != ::geteuid() ||
+        (status.st_mode & (S_IRWXG | S_IRWXO)) != 0)
+    {
+        return {};
+    }
+
+    return directory;
 #else
+    return {};
+#endif
+}
+
+/**
+ * Next to the instance first, the user cache directory is keyed by the hash alone
+ */
+auto getCachePaths(const std::filesystem::path& path, uint64_t sourceHash) -> std::vector<std::filesystem::path>
+{
+    auto result = std::vector<std::filesystem::path> {};
+
+    auto besideSource = path;
+    besideSource += ".tspcache";
+    result.push_back(std::move(besideSource));
+
+    if (const auto directory = getUserCacheDirectory())
+    {
+        auto name = std::array<char, 16> {};
+        const auto nameEnd = std::to_chars(name.data(), name.data() + name.size(), sourceHash, 16).ptr;
+
+        auto userCache = directory.value() / std::string_view {name.data(), nameEnd};
+        userCache += ".tspcache";
+        result.push_back(std::move(userCache));
+    }
+
+    return result;
+}
+
+#else
+
+auto getTspContent([[maybe_unused]] std::string_view input,
+                   [[maybe_unused]] const ParseOptions& options) -> std::optional<Content>
+{
+    return {};
+}
+
+template<GraphWeight W>
+auto getTspContentAs([[maybe_unused]] std::string_view input,
+                     [[maybe_unused]] const ParseOptions& options) -> std::optional<BasicContent<W>>
+{
+    return {};
+}
+
+auto getTspContentFromFile([[maybe_unused]] const std::filesystem::path& path,
+                           [[maybe_unused]] const ParseOptions& options) -> std::optional<Content>
+{
+    return {};
+}
+
+auto getTspContents(std::span<const std::filesystem::path> paths,
+                    [[maybe_unused]] uint32_t threads,
+                    [[maybe_unused]] const ParseOptions& options) -> std::vector<std::optional<Content>>
+{
+    return std::vector<std::optional<Content>>(paths.size());
+}
+
+auto CachedContent::open([[maybe_unused]] const std::filesystem::path& path) -> std::optional<CachedContent>
+{
+    return {};
+}
+
+auto writeTspCache([[maybe_unused]] const Content& content,
+                   [[maybe_unused]] uint64_t sourceHash,
+                   [[maybe_unused]] const std::filesystem::path& path) -> bool
+{
+    return false;
+}
 
-auto getTspContent([[maybe_unused]] std::string_view input) -> std::optional<Content>
+auto getTspContentCached([[maybe_unused]] const std::filesystem::path& path,
+                         [[maybe_unused]] const ParseOptions& options) -> std::optional<CachedContent>
+{
+    return {};
+}
+
+auto getTspHeader([[maybe_unused]] std::string_view input) -> std::optional<Header>
+{
+    return {};
+}
+
+auto getTspHeaderFromFile([[maybe_unused]] const std::filesystem::path& path) -> std::optional<Header>
+{
+    return {};
+}
+
+StreamReader::StreamReader([[maybe_unused]] size_t bufferSize, [[maybe_unused]] const ParseOptions& options)
+{
+
+}
+
+auto StreamReader::feed([[maybe_unused]] std::span<const char> chunk) -> bool
+{
+    return false;
+}
+
+auto StreamReader::finish() -> std::optional<Content>
 {
     return {};
 }
 
 #endif
+
+auto CachedContent::getMetaData() const -> const MetaData&
+{
+    return metaData;
+}
+
+auto CachedContent::getCoordinates() const -> const std::optional<Coordinates>&
+{
+    return coordinates;
+}
+
+auto CachedContent::getOrder() const -> size_t
+{
+    return order;
+}
+
+auto CachedContent::getSize() const -> size_t
+{
+    return size;
+}
+
+auto CachedContent::getRepresentation() const -> GraphRepresentation
+{
+    return representation;
+}
+
+auto CachedContent::getWeights() const -> std::span<const Graph::Weight>
+{
+    return weights;
+}
+
+auto CachedContent::getColumnIndices() const -> std::span<const Graph::Vertex>
+{
+    return columnIndices;
+}
+
+auto CachedContent::getRowOffsets() const -> std::span<const size_t>
+{
+    return rowOffsets;
 }
+
+auto CachedContent::getSourceHash() const -> uint64_t
+{
+    return sourceHash;
+}
+
+auto CachedContent::toContent() const -> Content
+{
+    auto graph = std::optional<Graph> {};
+
+    if (representation == GraphRepresentation::SPARSE_ROWS)
+    {
+        auto edges = std::vector<Graph::EdgeData> {};
+        edges.reserve(weights.size());
+
+        for (auto vertex = Graph::Vertex {}; vertex < order; vertex++)
+        {
+            for (auto i = rowOffsets[vertex]; i < rowOffsets[vertex + 1]; i++)
+            {
+                edges.push_back({{vertex, columnIndices[i]}, weights[i]});
+            }
+        }
+
+        graph = Graph::fromEdges(std::move(edges), order);
+    }
+    else if (representation == GraphRepresentation::PACKED_SYMMETRIC)
+    {
+        graph = Graph::fromSymmetricWeights({weights.begin(), weights.end()}, order);
+    }
+    else
+    {
+        auto buffer = Graph::WeightBuffer {};
+        buffer.reserve(order * Graph::paddedStride(order));
+        buffer.assign(weights.begin(), weights.end());
+
+        graph = Graph::fromWeights(std::move(buffer), order);
+    }
+
+    return {
+        .metaData = metaData,
+        .graph = std::move(graph.value()),
+        .coordinates = coordinates
+    };
+}
+
+auto narrowContent(Content content) -> AnyContent
+{
+    if (auto graph = convertGraph<int16_t>(content.graph))
+    {
+        return BasicContent<int16_t> {
+            .metaData = std::move(content.metaData),
+            .graph = std::move(graph).value(),
+            .coordinates = std::move(content.coordinates)
+        };
+    }
+
+    return content;
+}
+
+auto getNarrowestTspContent(std::string_view input, const ParseOptions& options) -> std::optional<AnyContent>
+{
+    if (auto narrow = getTspContentAs<int16_t>(input, options))
+    {
+        return std::move(narrow).value();
+    }
+
+    if (auto wide = getTspContent(input, options))
+    {
+        return std::move(wide).value();
+    }
+
+    return {};
+}
+
+template auto getTspContentAs<int16_t>(std::string_view input, const ParseOptions& options)
+    -> std::optional<BasicContent<int16_t>>;
+template auto getTspContentAs<int32_t>(std::string_view input, const ParseOptions& options)
+    -> std::optional<BasicContent<int32_t>>;
+template auto getTspContentAs<float>(std::string_view input, const ParseOptions& options)
+    -> std::optional<BasicContent<float>>;
+
+StreamReader::StreamReader(StreamReader&& other) noexcept = default;
+
+StreamReader::~StreamReader() = default;
+
+auto StreamReader::operator=(StreamReader&& other) noexcept -> StreamReader& = default;
+
+}
\ No newline at end of file
@@ -0,0 +1,189 @@
+#include "StatsCollector.h"
+
+#ifdef TSPLIB_PARSE_STATS
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace tsplib
+{
+
+namespace
+{
+
+thread_local detail::AllocationCounters* threadCounters = nullptr;
+
+/**
+ * Every block starts with its size, so that a deallocation knows how much memory it gives back
+ */
+constexpr auto HEADER_SIZE = size_t {__STDCPP_DEFAULT_NEW_ALIGNMENT__};
+
+auto recordAllocation(size_t size) -> void
+{
+    auto* const counters = threadCounters;
+
+    if (counters == nullptr)
+    {
+        return;
+    }
+
+    counters->allocations.fetch_add(1, std::memory_order_relaxed);
+    const auto held = counters->heldBytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed) +
+                      static_cast<int64_t>(size);
+
+    auto peak = counters->peakBytes.load(std::memory_order_relaxed);
+    while (held > peak && !counters->peakBytes.compare_exchange_weak(peak, held, std::memory_order_relaxed))
+    {
+
+    }
+}
+
+auto recordDeallocation(size_t size) -> void
+{
+    if (auto* const counters = threadCounters)
+    {
+        counters->heldBytes.fetch_sub(static_cast<int64_t>(size), std::memory_order_relaxed);
+    }
+}
+
+auto allocate(size_t size, size_t alignment) -> void*
+{
+    // The header takes a whole alignment unit, so the block behind it stays aligned
+    const auto offset = std::max(alignment, HEADER_SIZE);
+    const auto total = (size + offset + alignment - 1) / alignment * alignment;
+    auto* const base = static_cast<std::byte*>(alignment > HEADER_SIZE ? std::aligned_alloc(alignment, total)
+                                                                        : std::malloc(total));
+
+    if (base == nullptr)
+    {
+        throw std::bad_alloc {};
+    }
+
+    auto* const memory = base + offset;
+    std::memcpy(memory - sizeof(size), &size, sizeof(size));
+    recordAllocation(size);
+
+    return memory;
+}
+
+auto deallocate(void* memory, size_t alignment) noexcept -> void
+{
+    if (memory == nullptr)
+    {
+        return;
+    }
+
+    auto* const block = static_cast<std::byte*>(memory);
+    auto size = size_t {};
+    std::memcpy(&size, block - sizeof(size), sizeof(size));
+    recordDeallocation(size);
+
+    std::free(block - std::max(alignment, HEADER_SIZE));
+}
+
+}
+
+AllocationScope::AllocationScope(ParseStats* stats)
+    : stats {stats}
+    , previous {threadCounters}
+{
+    if (stats != nullptr)
+    {
+        threadCounters = &counters;
+    }
+}
+
+AllocationScope::~AllocationScope()
+{
+    if (stats != nullptr)
+    {
+        threadCounters = previous;
+        stats->allocations += counters.allocations.load();
+        stats->peakAllocatedBytes = std::max(stats->peakAllocatedBytes, static_cast<size_t>(counters.peakBytes.load()));
+    }
+}
+
+WorkerAllocationScope::WorkerAllocationScope(detail::AllocationCounters* counters)
+    : previous {std::exchange(threadCounters, counters)}
+{
+
+}
+
+WorkerAllocationScope::~WorkerAllocationScope()
+{
+    threadCounters = previous;
+}
+
+auto currentAllocationCounters() -> detail::AllocationCounters*
+{
+    return threadCounters;
+}
+
+}
+
+/**
+ * Allocations can only be counted by replacing the global allocation functions of the whole program
+ */
+auto operator new(size_t size) -> void*
+{
+    return tsplib::allocate(size, tsplib::HEADER_SIZE);
+}
+
+auto operator new[](size_t size) -> void*
+{
+    return tsplib::allocate(size, tsplib::HEADER_SIZE);
+}
+
+auto operator new(size_t size, std::align_val_t alignment) -> void*
+{
+    return tsplib::allocate(size, static_cast<size_t>(alignment));
+}
+
+auto operator new[](size_t size, std::align_val_t alignment) -> void*
+{
+    return tsplib::allocate(size, static_cast<size_t>(alignment));
+}
+
+auto operator delete(void* memory) noexcept -> void
+{
+    tsplib::deallocate(memory, tsplib::HEADER_SIZE);
+}
+
+auto operator delete[](void* memory) noexcept -> void
+{
+    tsplib::deallocate(memory, tsplib::HEADER_SIZE);
+}
+
+auto operator delete(void* memory, size_t) noexcept -> void
+{
+    tsplib::deallocate(memory, tsplib::HEADER_SIZE);
+}
+
+auto operator delete[](void* memory, size_t) noexcept -> void
+{
+    tsplib::deallocate(memory, tsplib::HEADER_SIZE);
+}
+
+auto operator delete(void* memory, std::align_val_t alignment) noexcept -> void
+{
+    tsplib::deallocate(memory, static_cast<size_t>(alignment));
+}
+
+auto operator delete[](void* memory, std::align_val_t alignment) noexcept -> void
+{
+    tsplib::deallocate(memory, static_cast<size_t>(alignment));
+}
+
+auto operator delete(void* memory, size_t, std::align_val_t alignment) noexcept -> void
+{
+    tsplib::deallocate(memory, static_cast<size_t>(alignment));
+}
+
+auto operator delete[](void* memory, size_t, std::align_val_t alignment) noexcept -> void
+{
+    tsplib::deallocate(memory, static_cast<size_t>(alignment));
+}
+
+#endif
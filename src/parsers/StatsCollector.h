@@ -0,0 +1,149 @@
+#pragma once
+
+#include "ParseStats.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+namespace tsplib
+{
+
+/**
+ * Everything below compiles to nothing without TSPLIB_PARSE_STATS
+ */
+
+namespace detail
+{
+
+struct AllocationCounters
+{
+#ifdef TSPLIB_PARSE_STATS
+    std::atomic<size_t> allocations {};
+    std::atomic<int64_t> heldBytes {};
+    std::atomic<int64_t> peakBytes {};
+#endif
+};
+
+}
+
+/**
+ * Adds its own lifetime to a stage of the statistics
+ */
+class StageTimer
+{
+public:
+    StageTimer([[maybe_unused]] ParseStats* stats, [[maybe_unused]] std::chrono::nanoseconds ParseStats::* stage)
+#ifdef TSPLIB_PARSE_STATS
+        : stats {stats}
+        , stage {stage}
+        , start {stats != nullptr ? Clock::now() : Clock::time_point {}}
+#endif
+    {
+
+    }
+
+    StageTimer(const StageTimer&) = delete;
+    auto operator=(const StageTimer&) -> StageTimer& = delete;
+
+    ~StageTimer()
+    {
+#ifdef TSPLIB_PARSE_STATS
+        if (stats != nullptr)
+        {
+            stats->*stage += Clock::now() - start;
+        }
+#endif
+    }
+
+#ifdef TSPLIB_PARSE_STATS
+private:
+    using Clock = std::chrono::steady_clock;
+
+    ParseStats* stats;
+    std::chrono::nanoseconds ParseStats::* stage;
+    Clock::time_point start;
+#endif
+};
+
+/**
+ * Counts the allocations of the current thread while it lives and adds them to the statistics
+ */
+class AllocationScope
+{
+public:
+    explicit AllocationScope([[maybe_unused]] ParseStats* stats)
+#ifdef TSPLIB_PARSE_STATS
+    ;
+#else
+    {
+
+    }
+#endif
+
+    AllocationScope(const AllocationScope&) = delete;
+    auto operator=(const AllocationScope&) -> AllocationScope& = delete;
+
+#ifdef TSPLIB_PARSE_STATS
+    ~AllocationScope();
+
+private:
+    ParseStats* stats;
+    detail::AllocationCounters counters;
+    detail::AllocationCounters* previous;
+#endif
+};
+
+/**
+ * Makes the allocations of a worker thread count for the thread that started it
+ */
+class WorkerAllocationScope
+{
+public:
+    explicit WorkerAllocationScope([[maybe_unused]] detail::AllocationCounters* counters)
+#ifdef TSPLIB_PARSE_STATS
+    ;
+#else
+    {
+
+    }
+#endif
+
+    WorkerAllocationScope(const WorkerAllocationScope&) = delete;
+    auto operator=(const WorkerAllocationScope&) -> WorkerAllocationScope& = delete;
+
+#ifdef TSPLIB_PARSE_STATS
+    ~WorkerAllocationScope();
+
+private:
+    detail::AllocationCounters* previous;
+#endif
+};
+
+/**
+ * Counters of the current thread, to be passed to the threads it starts
+ */
+#ifdef TSPLIB_PARSE_STATS
+[[nodiscard]]
+auto currentAllocationCounters() -> detail::AllocationCounters*;
+#else
+[[nodiscard]]
+inline auto currentAllocationCounters() -> detail::AllocationCounters*
+{
+    return nullptr;
+}
+#endif
+
+template<typename Update>
+auto updateStats([[maybe_unused]] ParseStats* stats, [[maybe_unused]] Update&& update) -> void
+{
+#ifdef TSPLIB_PARSE_STATS
+    if (stats != nullptr)
+    {
+        std::forward<Update>(update)(*stats);
+    }
+#endif
+}
+
+}
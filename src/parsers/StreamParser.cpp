@@ -0,0 +1,335 @@
+#include "StreamParser.h"
+#include "NumberScanner.h"
+#include "StatsCollector.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace tsplib
+{
+
+namespace
+{
+
+constexpr auto WHITESPACES = " \t\n\v\f\r"sv;
+
+auto isBlank(std::string_view input) -> bool
+{
+    return input.find_first_not_of(WHITESPACES) == std::string_view::npos;
+}
+
+}
+
+TspStreamParser::TspStreamParser(size_t bufferSize, const ParseOptions& options)
+    : options {options}
+    , buffer(bufferSize)
+{
+
+}
+
+auto TspStreamParser::feed(std::span<const char> chunk) -> bool
+{
+    const auto timer = StageTimer {options.stats, &ParseStats::tokenizing};
+
+    updateStats(options.stats, [&chunk](auto& stats) { stats.bytes += chunk.size(); });
+
+    while (!chunk.empty() && state != State::ERROR)
+    {
+        const auto size = std::min(chunk.size(), buffer.size() - bufferUsed);
+        std::memcpy(buffer.data() + bufferUsed, chunk.data(), size);
+        bufferUsed += size;
+        chunk = chunk.subspan(size);
+
+        // Parsing whole buffers keeps sections in large windows and moves the tail fewer times
+        if (bufferUsed < buffer.size())
+        {
+            break;
+        }
+
+        process(false);
+
+        if (bufferUsed == buffer.size())
+        {
+            state = State::ERROR;
+        }
+    }
+
+    return state != State::ERROR;
+}
+
+auto TspStreamParser::finish() -> std::optional<Config>
+{
+    if (state == State::ERROR)
+    {
+        return {};
+    }
+
+    {
+        const auto timer = StageTimer {options.stats, &ParseStats::tokenizing};
+
+        process(true);
+        state = State::DONE;
+
+        for (const auto& item : data.data)
+        {
+            updateStats(options.stats, [&item](auto& stats) { stats.tokens += countTokens(item); });
+        }
+    }
+
+    const auto timer = StageTimer {options.stats, &ParseStats::filtering};
+
+    return std::exchange(data, {}).filtered();
+}
+
+auto TspStreamParser::process(bool isFinal) -> void
+{
+    while (true)
+    {
+        const auto input = std::string_view {buffer.data(), bufferUsed};
+        const auto previousState = state;
+        auto consumed = size_t {};
+
+        switch (state)
+        {
+        case State::HEADER:
+            consumed = headerStep(input, isFinal);
+            break;
+        case State::INTEGERS_SECTION:
+            consumed = integersSectionStep(input, isFinal);
+            break;
+        case State::NODES_SECTION:
+            consumed = nodesSectionStep(input, isFinal);
+            break;
+        case State::DONE:
+            // tspData ignores everything after the first item it cannot parse
+            consumed = input.size();
+            break;
+        case State::ERROR:
+            return;
+        }
+
+        std::memmove(buffer.data(), buffer.data() + consumed, bufferUsed - consumed);
+        bufferUsed -= consumed;
+
+        if (consumed == 0 && state == previousState)
+        {
+            return;
+        }
+    }
+}
+
+auto TspStreamParser::headerStep(std::string_view input, bool isFinal) -> size_t
+{
+    const auto start = std::min(input.find_first_not_of(WHITESPACES), input.size());
+    const auto item = input.substr(start);
+
+    if (item.empty())
+    {
+        if (isFinal)
+        {
+            state = State::DONE;
+        }
+        return start;
+    }
+
+    auto lineEnd = item.find('\n');
+    if (lineEnd == std::string_view::npos)
+    {
+        if (!isFinal)
+        {
+            return start;
+        }
+        lineEnd = item.size();
+    }
+    else
+    {
+        lineEnd++;
+    }
+
+    const auto tagResult = tag(item.substr(0, lineEnd));
+    if (!tagResult)
+    {
+        state = State::DONE;
+        return start;
+    }
+
+    const auto tagSize = lineEnd - tagResult->second.size();
+
+    if (tagResult->first == EDGE_WEIGHT_SECTION || tagResult->first == EDGE_DATA_SECTION)
+    {
+        state = State::INTEGERS_SECTION;
+        sectionTag = tagResult->first == EDGE_WEIGHT_SECTION ? EDGE_WEIGHT_SECTION : EDGE_DATA_SECTION;
+        return start + tagSize;
+    }
+
+    if (tagResult->first == NODE_COORD_SECTION)
+    {
+        state = State::NODES_SECTION;
+        nodesDimension = NodesDimension::UNKNOWN;
+        return start + tagSize;
+    }
+
+    auto itemEnd = lineEnd;
+    if (isBlank(item.substr(tagSize, lineEnd - tagSize)))
+    {
+        // The value may follow on one of the next lines
+        const auto valueStart = item.find_first_not_of(WHITESPACES, lineEnd);
+        const auto valueEnd = valueStart == std::string_view::npos ? valueStart : item.find('\n', valueStart);
+
+        if (valueEnd == std::string_view::npos)
+        {
+            if (!isFinal)
+            {
+                return start;
+            }
+            itemEnd = item.size();
+        }
+        else
+        {
+            itemEnd = valueEnd + 1;
+        }
+    }
+
+    auto result = tspItem(item.substr(0, itemEnd));
+    if (!result)
+    {
+        state = State::DONE;
+        return start;
+    }
+
+    data.data.push_back(std::move(result->first));
+
+    return start + itemEnd - result->second.size();
+}
+
+auto TspStreamParser::integersSectionStep(std::string_view input, bool isFinal) -> size_t
+{
+    auto region = input;
+
+    if (!isFinal)
+    {
+        // Only tokens followed by a whitespace are complete
+        const auto lastWhitespace = input.find_last_of(WHITESPACES);
+        if (lastWhitespace == std::string_view::npos)
+        {
+            return 0;
+        }
+        region = input.substr(0, lastWhitespace + 1);
+    }
+
+    const auto rest = appendIntegers(region, integers, options.threads);
+
+    if (isFinal || !isBlank(rest))
+    {
+        finishIntegersSection();
+        return region.size() - rest.size();
+    }
+
+    return region.size();
+}
+
+auto TspStreamParser::nodesSectionStep(std::string_view input, bool isFinal) -> size_t
+{
+    auto window = input;
+
+    if (!isFinal)
+    {
+        // Only lines followed by an end of line are complete
+        const auto lastLineEnd = input.rfind('\n');
+        if (lastLineEnd == std::string_view::npos)
+        {
+            return 0;
+        }
+        window = input.substr(0, lastLineEnd + 1);
+    }
+
+    if (nodesDimension == NodesDimension::UNKNOWN)
+    {
+        // Same decision as nodeCoordSection makes: the first node tells whether all of them are 2D or 3D
+        const auto type = nodeCoordType(window);
+
+        if (type == NodeCoordType::_2D)
+        {
+            nodesDimension = NodesDimension::_2D;
+        }
+        else if (type == NodeCoordType::_3D)
+        {
+            nodesDimension = NodesDimension::_3D;
+        }
+        else if (isBlank(window) && !isFinal)
+        {
+            return window.size();
+        }
+        else
+        {
+            state = State::DONE;
+            return 0;
+        }
+    }
+
+    auto rest = window;
+
+    if (nodesDimension == NodesDimension::_2D)
+    {
+        if (auto result = tsplib::nodes2d(window, options))
+        {
+            auto& nodes = std::get<Nodes2d>(result->first.nodesCoord).nodes2d;
+            nodes2d.insert(nodes2d.end(), nodes.cbegin(), nodes.cend());
+            rest = result->second;
+        }
+    }
+    else
+    {
+        if (auto result = tsplib::nodes3d(window, options))
+        {
+            auto& nodes = std::get<Nodes3d>(result->first.nodesCoord).nodes3d;
+            nodes3d.insert(nodes3d.end(), nodes.cbegin(), nodes.cend());
+            rest = result->second;
+        }
+    }
+
+    if (isFinal || !isBlank(rest))
+    {
+        finishNodesSection();
+        return window.size() - rest.size();
+    }
+
+    return window.size();
+}
+
+auto TspStreamParser::finishIntegersSection() -> void
+{
+    if (integers.empty())
+    {
+        state = State::DONE;
+        return;
+    }
+
+    if (sectionTag == EDGE_WEIGHT_SECTION)
+    {
+        data.data.emplace_back(EdgeWeightSection {std::exchange(integers, {})});
+    }
+    else
+    {
+        data.data.emplace_back(EdgeDataSection {std::exchange(integers, {})});
+    }
+
+    state = State::HEADER;
+}
+
+auto TspStreamParser::finishNodesSection() -> void
+{
+    if (nodesDimension == NodesDimension::_2D)
+    {
+        data.data.emplace_back(NodeCoordSection {Nodes2d {std::exchange(nodes2d, {})}});
+    }
+    else
+    {
+        data.data.emplace_back(NodeCoordSection {Nodes3d {std::exchange(nodes3d, {})}});
+    }
+
+    state = State::HEADER;
+}
+
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "ParseOptions.h"
+#include "SubParsers.h"
+
+#include <span>
+
+namespace tsplib
+{
+
+/**
+ * Push parser producing the same Config as tspData from chunks of any size.
+ * Only the unconsumed tail of the input is kept, in a buffer of fixed size,
+ * so every header line and every node line has to fit in it.
+ * The buffer is parsed once it is full, so sections are split across the threads of the options
+ * in windows of the buffer size.
+ */
+class TspStreamParser
+{
+public:
+    static constexpr size_t DEFAULT_BUFFER_SIZE = size_t {1} << 16;
+
+    explicit TspStreamParser(size_t bufferSize = DEFAULT_BUFFER_SIZE, const ParseOptions& options = {});
+
+    /**
+     * Returns false if the input cannot be parsed, e.g. a line does not fit in the buffer
+     */
+    auto feed(std::span<const char> chunk) -> bool;
+
+    /**
+     * Parses the rest of the buffered input. No more chunks can be fed afterwards.
+     */
+    [[nodiscard]]
+    auto finish() -> std::optional<Config>;
+
+private:
+    enum class State
+    {
+        HEADER,
+        INTEGERS_SECTION,
+        NODES_SECTION,
+        DONE,
+        ERROR
+    };
+
+    enum class NodesDimension
+    {
+        UNKNOWN,
+        _2D,
+        _3D
+    };
+
+    auto process(bool isFinal) -> void;
+
+    /**
+     * Each step returns the number of consumed bytes
+     */
+    [[nodiscard]]
+    auto headerStep(std::string_view input, bool isFinal) -> size_t;
+    [[nodiscard]]
+    auto integersSectionStep(std::string_view input, bool isFinal) -> size_t;
+    [[nodiscard]]
+    auto nodesSectionStep(std::string_view input, bool isFinal) -> size_t;
+
+    auto finishIntegersSection() -> void;
+    auto finishNodesSection() -> void;
+
+    ParseOptions options;
+
+    std::vector<char> buffer;
+    size_t bufferUsed = 0;
+
+    State state = State::HEADER;
+    std::string_view sectionTag;
+    NodesDimension nodesDimension = NodesDimension::UNKNOWN;
+
+    utils::AlignedVector<int32_t> integers;
+    std::vector<Node2d> nodes2d;
+    std::vector<Node3d> nodes3d;
+
+    TspData data;
+};
+
+}
@@ -1,15 +1,116 @@
 #include "SubParsers.h"
+#include "GraphParser.h"
+#include "KeywordTable.h"
+#include "NumberScanner.h"
+#include "StatsCollector.h"
 
+#include <algorithm>
+#include <charconv>
 #include <iostream>
+#include <thread>
 
 namespace tsplib
 {
 
+namespace
+{
+
+enum class TagId
+{
+    NAME,
+    TYPE,
+    COMMENT,
+    DIMENSION,
+    CAPACITY,
+    EDGE_WEIGHT_TYPE,
+    EDGE_WEIGHT_FORMAT,
+    EDGE_DATA_FORMAT,
+    NODE_COORD_SECTION,
+    EDGE_DATA_SECTION,
+    EDGE_WEIGHT_SECTION
+};
+
+constexpr auto tagKeywords = KeywordTable {std::array {
+    Keyword {NAME,                TagId::NAME},
+    Keyword {TYPE,                TagId::TYPE},
+    Keyword {COMMENT,             TagId::COMMENT},
+    Keyword {DIMENSION,           TagId::DIMENSION},
+    Keyword {CAPACITY,            TagId::CAPACITY},
+    Keyword {EDGE_WEIGHT_TYPE,    TagId::EDGE_WEIGHT_TYPE},
+    Keyword {EDGE_WEIGHT_FORMAT,  TagId::EDGE_WEIGHT_FORMAT},
+    Keyword {EDGE_DATA_FORMAT,    TagId::EDGE_DATA_FORMAT},
+    Keyword {NODE_COORD_SECTION,  TagId::NODE_COORD_SECTION},
+    Keyword {EDGE_DATA_SECTION,   TagId::EDGE_DATA_SECTION},
+    Keyword {EDGE_WEIGHT_SECTION, TagId::EDGE_WEIGHT_SECTION}
+}};
+static_assert(tagKeywords.isPerfect());
+
+constexpr auto typeKeywords = KeywordTable {std::array {
+    Keyword {"TSP"sv,  AlgorithmType::TSP},
+    Keyword {"ATSP"sv, AlgorithmType::ATSP},
+    Keyword {"SOP"sv,  AlgorithmType::SOP},
+    Keyword {"HCP"sv,  AlgorithmType::HCP},
+    Keyword {"CRVP"sv, AlgorithmType::CRVP},
+    Keyword {"TOUR"sv, AlgorithmType::TOUR}
+}};
+static_assert(typeKeywords.isPerfect());
+
+constexpr auto edgeWeightTypeKeywords = KeywordTable {std::array {
+    Keyword {"EXPLICIT"sv, EdgeWeightType::EXPLICIT},
+    Keyword {"EUC_2D"sv,   EdgeWeightType::EUC},
+    Keyword {"EUC_3D"sv,   EdgeWeightType::EUC},
+    Keyword {"MAX_2D"sv,   EdgeWeightType::MAX},
+    Keyword {"MAX_3D"sv,   EdgeWeightType::MAX},
+    Keyword {"MAN_2D"sv,   EdgeWeightType::MAN},
+    Keyword {"MAN_3D"sv,   EdgeWeightType::MAN},
+    Keyword {"CEIL_2D"sv,  EdgeWeightType::CEIL},
+    Keyword {"GEO"sv,      EdgeWeightType::GEO}
+}};
+static_assert(edgeWeightTypeKeywords.isPerfect());
+
+constexpr auto edgeWeightFormatKeywords = KeywordTable {std::array {
+    Keyword {"FUNCTION"sv,       EdgeWeightFormat::FUNCTION},
+    Keyword {"FULL_MATRIX"sv,    EdgeWeightFormat::FULL_MATRIX},
+    Keyword {"UPPER_ROW"sv,      EdgeWeightFormat::UPPER_ROW},
+    Keyword {"LOWER_ROW"sv,      EdgeWeightFormat::LOWER_ROW},
+    Keyword {"UPPER_DIAG_ROW"sv, EdgeWeightFormat::UPPER_DIAG_ROW},
+    Keyword {"LOWER_DIAG_ROW"sv, EdgeWeightFormat::LOWER_DIAG_ROW},
+    Keyword {"UPPER_COL"sv,      EdgeWeightFormat::UPPER_COL},
+    Keyword {"LOWER_COL"sv,      EdgeWeightFormat::LOWER_COL},
+    Keyword {"UPPER_DIAG_COL"sv, EdgeWeightFormat::UPPER_DIAG_COL},
+    Keyword {"LOWER_DIAG_COL"sv, EdgeWeightFormat::LOWER_DIAG_COL}
+}};
+static_assert(edgeWeightFormatKeywords.isPerfect());
+
+constexpr auto edgeDataFormatKeywords = KeywordTable {std::array {
+    Keyword {"EDGE_LIST"sv, EdgeDataFormat::EDGE_LIST},
+    Keyword {"ADJ_LIST"sv,  EdgeDataFormat::ADJ_LIST}
+}};
+static_assert(edgeDataFormatKeywords.isPerfect());
+
+constexpr auto WHITESPACES = " \t\n\v\f\r"sv;
+constexpr auto WHITESPACES_NOT_EOL = " \t\v\f"sv;
+
+auto skipped(std::string_view input, std::string_view symbols) -> std::string_view
+{
+    return input.substr(std::min(input.find_first_not_of(symbols), input.size()));
+}
+
+/**
+ * Room for the section as the graph will hold it, see getWeightsCapacity. A format which is not given yet
+ * is taken for a full matrix. 0 if the dimension is not known yet.
+ */
+auto weightsCapacity(std::optional<uint32_t> dimension, std::optional<EdgeWeightFormat> format) -> size_t
+{
+    return dimension ? getWeightsCapacity(format.value_or(EdgeWeightFormat::FULL_MATRIX), dimension.value()) : 0;
+}
+}
+
 template<typename ItemT>
 auto tokenizedLine(std::string_view input) -> fp::Result<TspData::Item>
 {
     return fp::sequence(
-        [](const auto& name) { return ItemT {name}; },
+        [](auto name) { return ItemT {std::string {name}}; },
         fp::tokenLeft(fp::line)
     )(input);
 }
@@ -22,12 +123,17 @@ auto tokenizedNatural(std::string_view input) -> fp::Result<TspData::Item>
     )(input);
 }
 
-template<std::integral T, typename ItemT>
-auto tokenizedIntegers(std::string_view input) -> fp::Result<TspData::Item>
+template<typename ItemT>
+auto scannedIntegers(std::string_view input, const ParseOptions& options, size_t expectedCount) -> fp::Result<TspData::Item>
 {
-    return fp::sequence([](const auto& integers) { return ItemT {integers}; },
-                        fp::some(fp::tokenLeft(fp::integer<T>))
-    )(input);
+    auto result = integers(input, options.threads, expectedCount);
+
+    if (!result)
+    {
+        return {};
+    }
+
+    return {{ItemT {std::move(result->first)}, result->second}};
 }
 
 auto name(std::string_view input) -> fp::Result<TspData::Item>
@@ -42,19 +148,9 @@ auto comment(std::string_view input) -> fp::Result<TspData::Item>
 
 auto type(std::string_view input) -> fp::Result<TspData::Item>
 {
-    using
-    enum AlgorithmType;
-
     return fp::sequence(
         [](auto type) { return type; },
-        fp::tokenLeft(fp::choice(
-            fp::sequence([](const auto&) { return TSP; }, fp::str("TSP")),
-            fp::sequence([](const auto&) { return ATSP; }, fp::str("ATSP")),
-            fp::sequence([](const auto&) { return SOP; }, fp::str("SOP")),
-            fp::sequence([](const auto&) { return HCP; }, fp::str("HCP")),
-            fp::sequence([](const auto&) { return CRVP; }, fp::str("CRVP")),
-            fp::sequence([](const auto&) { return TOUR; }, fp::str("TOUR"))
-        ))
+        fp::tokenLeft(keyword(typeKeywords))
     )(input);
 }
 
@@ -70,177 +166,498 @@ auto capacity(std::string_view input) -> fp::Result<TspData::Item>
 
 auto edgeWeightType(std::string_view input) -> fp::Result<TspData::Item>
 {
-    using
-    enum EdgeWeightType;
-
     return fp::sequence(
         [](auto type) { return type; },
-        fp::tokenLeft(fp::choice(
-            fp::sequence([](const auto&) { return EXPLICIT; }, fp::str("EXPLICIT")),
-            fp::sequence([](const auto&) { return EUC; }, fp::str("EUC_2D")),
-            fp::sequence([](const auto&) { return EUC; }, fp::str("EUC_3D")),
-            fp::sequence([](const auto&) { return MAX; }, fp::str("MAX_2D")),
-            fp::sequence([](const auto&) { return MAX; }, fp::str("MAX_3D")),
-            fp::sequence([](const auto&) { return MAN; }, fp::str("MAN_2D")),
-            fp::sequence([](const auto&) { return MAN; }, fp::str("MAN_3D")),
-            fp::sequence([](const auto&) { return CEIL; }, fp::str("CEIL_2D")),
-            fp::sequence([](const auto&) { return GEO; }, fp::str("GEO"))
-        ))
+        fp::tokenLeft(keyword(edgeWeightTypeKeywords))
     )(input);
 }
 
 auto edgeWeightFormat(std::string_view input) -> fp::Result<TspData::Item>
 {
-    using
-    enum EdgeWeightFormat;
-
     return fp::sequence(
         [](auto format) { return format; },
-        fp::tokenLeft(fp::choice(
-            fp::sequence([](const auto&) { return FUNCTION; }, fp::str("FUNCTION")),
-            fp::sequence([](const auto&) { return FULL_MATRIX; }, fp::str("FULL_MATRIX")),
-            fp::sequence([](const auto&) { return UPPER_ROW; }, fp::str("UPPER_ROW")),
-            fp::sequence([](const auto&) { return LOWER_ROW; }, fp::str("LOWER_ROW")),
-            fp::sequence([](const auto&) { return UPPER_DIAG_ROW; }, fp::str("UPPER_DIAG_ROW")),
-            fp::sequence([](const auto&) { return LOWER_DIAG_ROW; }, fp::str("LOWER_DIAG_ROW")),
-            fp::sequence([](const auto&) { return UPPER_COL; }, fp::str("UPPER_COL")),
-            fp::sequence([](const auto&) { return LOWER_COL; }, fp::str("LOWER_COL")),
-            fp::sequence([](const auto&) { return UPPER_DIAG_COL; }, fp::str("UPPER_DIAG_COL")),
-            fp::sequence([](const auto&) { return LOWER_DIAG_COL; }, fp::str("LOWER_DIAG_COL"))
-        ))
+        fp::tokenLeft(keyword(edgeWeightFormatKeywords))
     )(input);
 }
 
 auto edgeDataFormat(std::string_view input) -> fp::Result<TspData::Item>
 {
-    using
-    enum EdgeDataFormat;
-
     return fp::sequence(
         [](auto format) { return format; },
-        fp::tokenLeft(fp::choice(
-            fp::sequence([](const auto&) { return EDGE_LIST; }, fp::str("EDGE_LIST")),
-            fp::sequence([](const auto&) { return ADJ_LIST; }, fp::str("ADJ_LIST"))
-        ))
+        fp::tokenLeft(keyword(edgeDataFormatKeywords))
     )(input);
 }
 
+/**
+ * Reads a node id followed by CoordinatesCount coordinates, all of them on a single line
+ */
+template<size_t CoordinatesCount>
+auto scannedNode(std::string_view input) -> fp::Result<std::pair<uint32_t, std::array<double, CoordinatesCount>>>
+{
+    auto id = uint32_t {};
+    const auto [idEnd, code] = std::from_chars(input.data(), input.data() + input.size(), id);
+
+    if (code != std::errc {})
+    {
+        return {};
+    }
+
+    auto rest = input.substr(static_cast<size_t>(idEnd - input.data()));
+    auto coordinates = std::array<double, CoordinatesCount> {};
+
+    for (auto& coordinate : coordinates)
+    {
+        const auto separated = skipped(rest, WHITESPACES_NOT_EOL);
+        if (separated.size() == rest.size())
+        {
+            return {};
+        }
+
+        const auto result = real(separated);
+        if (!result)
+        {
+            return {};
+        }
+
+        coordinate = result->first;
+        rest = result->second;
+    }
+
+    rest = skipped(rest, WHITESPACES_NOT_EOL);
+
+    if (rest.empty() || !fp::isEol(rest.front()))
+    {
+        return {};
+    }
+
+    return {{{id, coordinates}, rest.substr(1)}};
+}
+
+/**
+ * Single forward pass over the node lines, stops in front of the first line which is not a node
+ */
+template<typename NodeT, typename NodeParserT>
+auto scannedNodes(std::string_view input, NodeParserT node) -> fp::Result<std::vector<NodeT>>
+{
+    auto nodes = std::vector<NodeT> {};
+    auto rest = input;
+
+    while (auto result = node(skipped(rest, WHITESPACES)))
+    {
+        nodes.push_back(result->first);
+        rest = result->second;
+    }
+
+    if (nodes.empty())
+    {
+        return {};
+    }
+
+    return {{std::move(nodes), rest}};
+}
+
+/**
+ * Splits the node lines at line ends into chunks of at least minChunkSize bytes, scans them on separate threads
+ * and concatenates the nodes in order. The result is the same as the one of a single pass.
+ */
+template<typename NodeT, typename NodeParserT>
+auto scannedNodesParallel(std::string_view input, NodeParserT node, uint32_t threads, size_t minChunkSize)
+    -> fp::Result<std::vector<NodeT>>
+{
+    // Only digits, signs, points, exponents and whitespaces can belong to the section, so it cannot reach past them
+    const auto sectionSize = static_cast<size_t>(std::ranges::find_if(input, [](char symbol) {
+        return charClassOf(symbol) == CharClass::OTHER && symbol != '+' && symbol != '.' && symbol != 'e' && symbol != 'E';
+    }) - input.begin());
+    const auto chunksCount = std::clamp<size_t>(sectionSize / std::max<size_t>(minChunkSize, 1), 1, threads);
+
+    auto boundaries = std::vector<size_t> {0};
+    for (auto i = size_t {1}; i < chunksCount; i++)
+    {
+        const auto lineEnd = input.substr(0, sectionSize).find('\n', std::max(sectionSize * i / chunksCount, boundaries.back()));
+        boundaries.push_back(lineEnd == std::string_view::npos ? sectionSize : lineEnd + 1);
+    }
+    boundaries.push_back(sectionSize);
+
+    auto partialResults = std::vector<std::vector<NodeT>>(chunksCount);
+    auto partialRests = std::vector<std::string_view>(chunksCount);
+    {
+        auto workers = std::vector<std::jthread> {};
+        workers.reserve(chunksCount - 1);
+
+        auto* const allocationCounters = currentAllocationCounters();
+        const auto scanChunk = [&](size_t i) {
+            // The last chunk goes on to the end, where the line of the last node ends
+            const auto chunk = i + 1 < chunksCount ? input.substr(boundaries[i], boundaries[i + 1] - boundaries[i])
+                                                   : input.substr(boundaries[i]);
+            auto nodes = scannedNodes<NodeT>(chunk, node);
+            partialRests[i] = nodes ? nodes->second : chunk;
+            if (nodes)
+            {
+                partialResults[i] = std::move(nodes->first);
+            }
+        };
+
+        for (auto i = size_t {1}; i < chunksCount; i++)
+        {
+            workers.emplace_back([&, i] {
+                [[maybe_unused]] const auto allocationScope = WorkerAllocationScope {allocationCounters};
+                scanChunk(i);
+            });
+        }
+
+        scanChunk(0);
+    }
+
+    auto totalSize = size_t {};
+    for (const auto& partialResult : partialResults)
+    {
+        totalSize += partialResult.size();
+    }
+
+    auto result = std::vector<NodeT> {};
+    result.reserve(totalSize);
+    auto rest = input;
+
+    for (auto i = size_t {}; i < chunksCount; i++)
+    {
+        if (!partialResults[i].empty())
+        {
+            result.insert(result.end(), partialResults[i].cbegin(), partialResults[i].cend());
+            partialResults[i] = {};
+            rest = partialRests[i];
+        }
+
+        // The single pass would have stopped inside this chunk, so nothing after it counts
+        if (std::ranges::any_of(partialRests[i], [](auto symbol) { return charClassOf(symbol) != CharClass::WHITESPACE; }))
+        {
+            break;
+        }
+    }
+
+    if (result.empty())
+    {
+        return {};
+    }
+
+    return {{std::move(result), rest}};
+}
+
+template<typename NodeT, typename NodeParserT>
+auto scannedNodes(std::string_view input, NodeParserT node, uint32_t threads) -> fp::Result<std::vector<NodeT>>
+{
+    static constexpr auto minChunkSize = size_t {1} << 20;
+
+    if (threads > 1 && input.size() >= 2 * minChunkSize)
+    {
+        return scannedNodesParallel<NodeT>(input, node, threads, minChunkSize);
+    }
+
+    return scannedNodes<NodeT>(input, node);
+}
+
 auto node2d(std::string_view input) -> fp::Result<Node2d>
 {
-    return fp::sequence(
-        [](auto id, const auto&,
-           auto x, const auto&,
-           auto y, auto) { return Node2d {id, x, y}; },
-        fp::natural<uint32_t>,
-        fp::some(fp::whitespaceNotEol),
-        fp::real<double>,
-        fp::some(fp::whitespaceNotEol),
-        fp::tokenRight(fp::real<double>, fp::whitespacesNotEol),
-        fp::eol
-    )(input);
+    const auto node = scannedNode<2>(input);
+
+    if (!node)
+    {
+        return {};
+    }
+
+    const auto& [id, coordinates] = node->first;
+
+    return {{Node2d {id, coordinates[0], coordinates[1]}, node->second}};
 }
 
-auto nodes2d(std::string_view input) -> fp::Result<NodeCoordSection>
+auto nodes2d(std::string_view input, const ParseOptions& options) -> fp::Result<NodeCoordSection>
 {
-    return fp::sequence(
-        [](const auto& nodes) { return NodeCoordSection {Nodes2d {nodes}}; },
-        fp::some(fp::tokenLeft(node2d))
-    )(input);
+    auto nodes = scannedNodes<Node2d>(input, node2d, options.threads);
+
+    if (!nodes)
+    {
+        return {};
+    }
+
+    return {{NodeCoordSection {Nodes2d {std::move(nodes->first)}}, nodes->second}};
 }
 
 auto node3d(std::string_view input) -> fp::Result<Node3d>
 {
-    return fp::sequence(
-        [](auto id, const auto&,
-           auto x, const auto&,
-           auto y, const auto&,
-           auto z, auto) {
-            return Node3d {id, x, y, z};
-        },
-        fp::natural<uint32_t>,
-        fp::some(fp::whitespaceNotEol),
-        fp::real<double>,
-        fp::some(fp::whitespaceNotEol),
-        fp::real<double>,
-        fp::some(fp::whitespaceNotEol),
-        fp::tokenRight(fp::real<double>, fp::whitespacesNotEol),
-        fp::eol
-    )(input);
+    const auto node = scannedNode<3>(input);
+
+    if (!node)
+    {
+        return {};
+    }
+
+    const auto& [id, coordinates] = node->first;
+
+    return {{Node3d {id, coordinates[0], coordinates[1], coordinates[2]}, node->second}};
 }
 
-auto nodes3d(std::string_view input) -> fp::Result<NodeCoordSection>
+auto nodes3d(std::string_view input, const ParseOptions& options) -> fp::Result<NodeCoordSection>
 {
-    return fp::sequence([](const auto& nodes) { return NodeCoordSection {Nodes3d {nodes}}; },
-                        fp::some(fp::tokenLeft(node3d))
-    )(input);
+    auto nodes = scannedNodes<Node3d>(input, node3d, options.threads);
+
+    if (!nodes)
+    {
+        return {};
+    }
+
+    return {{NodeCoordSection {Nodes3d {std::move(nodes->first)}}, nodes->second}};
 }
 
-auto nodeCoordSection(std::string_view input) -> fp::Result<TspData::Item>
+auto nodeCoordType(std::string_view input) -> std::optional<NodeCoordType>
 {
-    return fp::sequence([](const auto& nodes) { return NodeCoordSection {nodes}; },
-                        fp::choice(
-                            nodes2d,
-                            nodes3d)
-    )(input);
+    const auto firstNode = skipped(input, WHITESPACES);
+
+    if (node2d(firstNode))
+    {
+        return NodeCoordType::_2D;
+    }
+    if (node3d(firstNode))
+    {
+        return NodeCoordType::_3D;
+    }
+
+    return {};
+}
+
+auto nodeCoordSection(std::string_view input, const ParseOptions& options) -> fp::Result<TspData::Item>
+{
+    switch (nodeCoordType(input).value_or(NodeCoordType::NO_COORD))
+    {
+    case NodeCoordType::_2D:
+        return nodes2d(input, options);
+    case NodeCoordType::_3D:
+        return nodes3d(input, options);
+    default:
+        return {};
+    }
 }
 
-auto edgeDataSection(std::string_view input) -> fp::Result<TspData::Item>
+auto edgeDataSection(std::string_view input, const ParseOptions& options) -> fp::Result<TspData::Item>
 {
-    return tokenizedIntegers<int32_t, EdgeDataSection>(input);
+    return scannedIntegers<EdgeDataSection>(input, options, 0);
 }
 
-auto edgeWeightSection(std::string_view input) -> fp::Result<TspData::Item>
+auto edgeWeightSection(std::string_view input, const ParseOptions& options, size_t expectedCount) -> fp::Result<TspData::Item>
 {
-    return tokenizedIntegers<int32_t, EdgeWeightSection>(input);
+    return scannedIntegers<EdgeWeightSection>(input, options, expectedCount);
 }
 
-auto tag(std::string_view input) -> fp::Result<std::string>
+auto tag(std::string_view input) -> fp::Result<std::string_view>
 {
-    return fp::sequence([](const auto& tag, auto) { return tag; },
-                        fp::many(fp::satisfy([](auto symbol) { return symbol != ':' && !::isspace(symbol); })),
-                        fp::maybe(fp::tokenLeft(fp::symbol(':')))
-                        )(input);
+    const auto size = std::min(input.find_first_of(": \t\n\v\f\r"), input.size());
+    const auto rest = fp::maybe(fp::tokenLeft(fp::symbol(':')))(input.substr(size));
+
+    return {{input.substr(0, size), rest->second}};
 }
 
-auto getParser(std::string_view tag) -> fp::Parser auto
+auto unknownItem(std::string_view input) -> fp::Result<TspData::Item>
 {
-    using ParserT = std::function<fp::Result<TspData::Item>(std::string_view)>;
-    static const auto tagMap = std::unordered_map<std::string_view, ParserT> {
-        {NAME,                name},
-        {TYPE,                type},
-        {COMMENT,             comment},
-        {DIMENSION,           dimension},
-        {CAPACITY,            capacity},
-        {EDGE_WEIGHT_TYPE,    edgeWeightType},
-        {EDGE_WEIGHT_FORMAT,  edgeWeightFormat},
-        {EDGE_DATA_FORMAT,    edgeDataFormat},
-        {NODE_COORD_SECTION,  nodeCoordSection},
-        {EDGE_DATA_SECTION,   edgeDataSection},
-        {EDGE_WEIGHT_SECTION, edgeWeightSection}
-    };
+    return fp::sequence([](const auto&) -> TspData::Item { return {}; }, fp::line)(input);
+}
 
-    const auto it = tagMap.find(tag);
+auto tspItem(std::string_view input, const ParseOptions& options, size_t expectedWeights) -> fp::Result<TspData::Item>
+{
+    const auto tagResult = fp::tokenLeft(tag)(input);
 
-    if (it == tagMap.cend())
+    if (!tagResult)
     {
-        return ParserT {fp::sequence([](const auto&) -> TspData::Item { return {}; }, fp::line)};
+        return {};
     }
-    else
+
+    const auto rest = tagResult->second;
+    const auto tagId = tagKeywords.find(tagResult->first);
+
+    if (!tagId)
     {
-        return it->second;
+        return unknownItem(rest);
+    }
+
+    switch (tagId.value())
+    {
+    case TagId::NAME:
+        return name(rest);
+    case TagId::TYPE:
+        return type(rest);
+    case TagId::COMMENT:
+        return comment(rest);
+    case TagId::DIMENSION:
+        return dimension(rest);
+    case TagId::CAPACITY:
+        return capacity(rest);
+    case TagId::EDGE_WEIGHT_TYPE:
+        return edgeWeightType(rest);
+    case TagId::EDGE_WEIGHT_FORMAT:
+        return edgeWeightFormat(rest);
+    case TagId::EDGE_DATA_FORMAT:
+        return edgeDataFormat(rest);
+    case TagId::NODE_COORD_SECTION:
+        return nodeCoordSection(rest, options);
+    case TagId::EDGE_DATA_SECTION:
+        return edgeDataSection(rest, options);
+    case TagId::EDGE_WEIGHT_SECTION:
+        return edgeWeightSection(rest, options, expectedWeights);
+    default:
+        return unknownItem(rest);
     }
 }
 
-auto tspData(std::string_view input) -> fp::Result<Config>
+auto countTokens(const TspData::Item& item) -> size_t
 {
-    const auto parser = fp::chain(fp::tokenLeft(tag), [](const auto& tagName) {
-        return getParser(tagName);
-    });
-    return fp::sequence([](const auto& data) { return TspData {data}.filtered(); },
-                        fp::many(
-                            fp::sequence([](const auto& item) -> TspData::Item { return item; }, parser)
-                        )
-    )(input);
+    return std::visit(match{
+        [](const EdgeWeightSection& section) { return section.weights.size(); },
+        [](const EdgeDataSection& section) { return section.edgeData.size(); },
+        [](const NodeCoordSection& section) {
+            return std::visit(match{
+                [](const Nodes2d& nodes) { return 3 * nodes.nodes2d.size(); },
+                [](const Nodes3d& nodes) { return 4 * nodes.nodes3d.size(); },
+            }, section.nodesCoord);
+        },
+        [](const auto&) { return size_t {1}; },
+    }, item);
+}
+
+auto tspData(std::string_view input, const ParseOptions& options) -> fp::Result<Config>
+{
+    auto data = TspData {};
+    auto dimension = std::optional<uint32_t> {};
+    auto format = std::optional<EdgeWeightFormat> {};
+    auto rest = input;
+
+    {
+        const auto timer = StageTimer {options.stats, &ParseStats::tokenizing};
+
+        while (auto item = tspItem(rest, options, weightsCapacity(dimension, format)))
+        {
+            // A parser which does not consume anything would match forever
+            if (item->second.size() == rest.size())
+            {
+                break;
+            }
+
+            if (const auto* itemDimension = std::get_if<Dimension>(&item->first))
+            {
+                dimension = itemDimension->dimension;
+            }
+
+            if (const auto* itemFormat = std::get_if<EdgeWeightFormat>(&item->first))
+            {
+                format = *itemFormat;
+            }
+
+            updateStats(options.stats, [&item](auto& stats) { stats.tokens += countTokens(item->first); });
+
+            data.data.push_back(std::move(item->first));
+            rest = item->second;
+        }
+    }
+
+    const auto timer = StageTimer {options.stats, &ParseStats::filtering};
+
+    return {{std::move(data).filtered(), rest}};
+}
+
+auto isSectionTag(std::string_view tag) -> bool
+{
+    return tag.ends_with("_SECTION");
+}
+
+/**
+ * Specification tags whose value is a keyword, TSPLIB defines more of them than the reader supports
+ */
+auto isKeywordTag(std::string_view tag) -> bool
+{
+    return tag == TYPE || tag == EDGE_WEIGHT_TYPE || tag == EDGE_WEIGHT_FORMAT || tag == EDGE_DATA_FORMAT;
+}
+
+/**
+ * Data sections consist of numbers only, so a section ends at the first line starting with a letter
+ */
+auto skipSection(std::string_view input) -> std::string_view
+{
+    while (!input.empty())
+    {
+        const auto lineStart = input.find_first_not_of(" \t\n\v\f\r");
+        if (lineStart == std::string_view::npos)
+        {
+            return {};
+        }
+
+        if (::isalpha(static_cast<unsigned char>(input[lineStart])))
+        {
+            return input.substr(lineStart);
+        }
+
+        const auto lineEnd = input.find('\n', lineStart);
+        if (lineEnd == std::string_view::npos)
+        {
+            return {};
+        }
+
+        input.remove_prefix(lineEnd + 1);
+    }
+
+    return input;
+}
+
+auto specificationIndex(std::string_view input) -> std::optional<SpecificationIndex>
+{
+    auto index = SpecificationIndex {};
+    auto data = TspData {};
+    auto rest = input;
+
+    while (true)
+    {
+        const auto itemStart = fp::whitespaces(rest)->second;
+        if (itemStart.empty())
+        {
+            break;
+        }
+
+        const auto tagResult = tag(itemStart);
+        if (!tagResult || tagResult->first == END_OF_FILE)
+        {
+            break;
+        }
+
+        if (isSectionTag(tagResult->first))
+        {
+            index.sections.push_back({std::string {tagResult->first}, input.size() - itemStart.size()});
+            rest = skipSection(tagResult->second);
+            continue;
+        }
+
+        const auto keyword = fp::tokenLeft(fp::many(fp::satisfy(std::not_fn(::isspace))),
+                                           fp::whitespacesNotEol)(tagResult->second);
+
+        if (tagResult->first == EDGE_WEIGHT_TYPE)
+        {
+            index.edgeWeightTypeKeyword = std::string {keyword->first};
+        }
+
+        auto item = tspItem(itemStart);
+        if (!item)
+        {
+            // An unsupported keyword, e.g. EDGE_WEIGHT_TYPE: ATT, leaves the line out and the rest readable
+            if (!isKeywordTag(tagResult->first) || keyword->first.empty())
+            {
+                return {};
+            }
+
+            rest = keyword->second;
+            continue;
+        }
+
+        data.data.push_back(std::move(item->first));
+        rest = item->second;
+    }
+
+    index.specification = std::move(data).filtered().specification;
+
+    return index;
 }
 
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Parser.h"
+#include "ParseOptions.h"
 #include "Tags.h"
 
 namespace tsplib
@@ -37,24 +38,63 @@ auto edgeDataFormat(std::string_view input) -> fp::Result<TspData::Item>;
 auto node2d(std::string_view input) -> fp::Result<Node2d>;
 
 [[nodiscard]]
-auto nodes2d(std::string_view input) -> fp::Result<NodeCoordSection>;
+auto nodes2d(std::string_view input, const ParseOptions& options = {}) -> fp::Result<NodeCoordSection>;
 
 [[nodiscard]]
 auto node3d(std::string_view input) -> fp::Result<Node3d>;
 
 [[nodiscard]]
-auto nodes3d(std::string_view input) -> fp::Result<NodeCoordSection>;
+auto nodes3d(std::string_view input, const ParseOptions& options = {}) -> fp::Result<NodeCoordSection>;
 
+/**
+ * Tells from the first node whether the section holds 2D or 3D coordinates
+ */
 [[nodiscard]]
-auto nodeCoordSection(std::string_view input) -> fp::Result<TspData::Item>;
+auto nodeCoordType(std::string_view input) -> std::optional<NodeCoordType>;
 
+/**
+ * Dimensionality is decided once by nodeCoordType, the section is then read in a single pass,
+ * or split at line ends and read on the given number of threads if it is large
+ */
 [[nodiscard]]
-auto edgeDataSection(std::string_view input) -> fp::Result<TspData::Item>;
+auto nodeCoordSection(std::string_view input, const ParseOptions& options = {}) -> fp::Result<TspData::Item>;
 
 [[nodiscard]]
-auto edgeWeightSection(std::string_view input) -> fp::Result<TspData::Item>;
+auto edgeDataSection(std::string_view input, const ParseOptions& options = {}) -> fp::Result<TspData::Item>;
 
+/**
+ * Space for expectedCount weights is reserved up front, so the section is not reallocated while growing.
+ * tspData reserves what the graph keeps, a padded matrix for FULL_MATRIX and the triangle for the other formats.
+ */
 [[nodiscard]]
-auto tspData(std::string_view input) -> fp::Result<Config>;
+auto edgeWeightSection(std::string_view input, const ParseOptions& options = {}, size_t expectedCount = 0)
+    -> fp::Result<TspData::Item>;
+
+[[nodiscard]]
+auto tag(std::string_view input) -> fp::Result<std::string_view>;
+
+/**
+ * Parses a tag together with its value or section. expectedWeights sizes an EDGE_WEIGHT_SECTION up front.
+ */
+[[nodiscard]]
+auto tspItem(std::string_view input, const ParseOptions& options = {}, size_t expectedWeights = 0)
+    -> fp::Result<TspData::Item>;
+
+[[nodiscard]]
+auto tspData(std::string_view input, const ParseOptions& options = {}) -> fp::Result<Config>;
+
+/**
+ * A specification item is a single token, the numbers of a section are counted one by one
+ */
+[[nodiscard]]
+auto countTokens(const TspData::Item& item) -> size_t;
+
+/**
+ * Parses only the specification items, data sections are skipped line by line without being tokenized
+ * and only their offsets are recorded. tspItem parses a section from its offset on demand.
+ * Returns nothing if the input holds something which is neither an item nor a section.
+ */
+[[nodiscard]]
+auto specificationIndex(std::string_view input) -> std::optional<SpecificationIndex>;
 
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "utils/AlignedAllocator.h"
+
 #include <string>
 #include <variant>
 #include <vector>
@@ -151,7 +153,7 @@ struct DemandSection
 
 struct EdgeDataSection
 {
-    std::vector<int32_t> edgeData;
+    utils::AlignedVector<int32_t> edgeData;
 };
 
 struct FixedEdgesSection
@@ -171,13 +173,23 @@ struct TourSection
 
 struct EdgeWeightSection
 {
-    std::vector<int32_t> weights;
+    utils::AlignedVector<int32_t> weights;
 };
 
 struct Config;
 
+/**
+ * Sections may hold the whole instance, so TspData and Config can only be moved
+ */
 struct TspData
 {
+    TspData() = default;
+    TspData(const TspData&) = delete;
+    TspData(TspData&&) noexcept = default;
+    auto operator=(const TspData&) -> TspData& = delete;
+    auto operator=(TspData&&) noexcept -> TspData& = default;
+    ~TspData() = default;
+
     using Item = std::variant<
         std::monostate,
         Name,
@@ -195,8 +207,11 @@ struct TspData
     >;
     std::vector<Item> data;
 
+    /**
+     * Moves the items into a Config, later items override earlier ones
+     */
     [[nodiscard]]
-    auto filtered() -> Config;
+    auto filtered() && -> Config;
 };
 
 struct Specification
@@ -218,18 +233,38 @@ struct Data
     std::optional<std::variant<Nodes2d, Nodes3d>> nodeCoordSection;
     //std::optional<std::vector<uint32_t>> depotSection; TODO
     //std::optional<std::vector<uint32_t>> demandSection; TODO
-    std::optional<std::vector<int32_t>> edgeDataSection;
+    std::optional<utils::AlignedVector<int32_t>> edgeDataSection;
     //std::optional<std::vector<uint32_t>> fixedEdgesSection; TODO
     // displayDataSection TODO
     // tourSection TODO
-    std::optional<std::vector<int32_t>> edgeWeightSection;
+    std::optional<utils::AlignedVector<int32_t>> edgeWeightSection;
 };
 
 struct Config
 {
+    Config() = default;
+    Config(const Config&) = delete;
+    Config(Config&&) noexcept = default;
+    auto operator=(const Config&) -> Config& = delete;
+    auto operator=(Config&&) noexcept -> Config& = default;
+    ~Config() = default;
+
     Specification specification;
     Data data;
 };
 
 
-}
+struct SectionOffset
+{
+    std::string tag;
+    size_t offset;
+};
+
+struct SpecificationIndex
+{
+    Specification specification;
+    std::optional<std::string> edgeWeightTypeKeyword;
+    std::vector<SectionOffset> sections;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define TSPLIB_AVX2_DISPATCH
+#endif
+
+namespace tsplib::utils
+{
+
+/**
+ * Functions with AVX2 code are compiled with a target attribute, so this has to be checked before calling them
+ */
+inline auto isAvx2Supported() -> bool
+{
+#ifdef TSPLIB_AVX2_DISPATCH
+    static const auto isSupported = __builtin_cpu_supports("avx2") != 0;
+    return isSupported;
+#else
+    return false;
+#endif
+}
+
+}
@@ -0,0 +1,475 @@
+#include <gtest/gtest.h>
+
+#include "Graph.h"
+
+#include <ranges>
+#include <sstream>
+
+TEST(GraphTest, FromWeights)
+{
+    const auto inf = tsplib::Graph::INFINITY_WEIGHT;
+    auto weights = tsplib::Graph::WeightBuffer {
+        0,   1,   2,
+        3,   4,   inf,
+        5,   6,   7
+    };
+
+    const auto graph = tsplib::Graph::fromWeights(std::move(weights), 3);
+
+    ASSERT_NO_THROW(graph.value());
+    EXPECT_EQ(graph->getOrder(), 3);
+    EXPECT_EQ(graph->getSize(), 5);
+    EXPECT_FALSE(graph->getWeight({1, 1}).has_value());
+    EXPECT_FALSE(graph->getWeight({1, 2}).has_value());
+    EXPECT_EQ(graph->getWeight({1, 0}).value(), 3);
+    EXPECT_EQ(graph->getWeight({2, 1}).value(), 6);
+
+    EXPECT_FALSE(tsplib::Graph::fromWeights({1, 2, 3}, 2).has_value());
+}
+
+TEST(GraphTest, SetOrder)
+{
+    auto graph = tsplib::Graph {2};
+    ASSERT_TRUE(graph.addEdge({{0, 1}, 10}));
+    ASSERT_TRUE(graph.addEdge({{1, 0}, 20}));
+
+    graph.setOrder(3);
+    EXPECT_EQ(graph.getOrder(), 3);
+    EXPECT_EQ(graph.getSize(), 2);
+    EXPECT_EQ(graph.getWeight({0, 1}).value(), 10);
+    EXPECT_EQ(graph.getWeight({1, 0}).value(), 20);
+    EXPECT_TRUE(graph.addEdge({{2, 0}, 30}));
+
+    graph.setOrder(1);
+    EXPECT_EQ(graph.getOrder(), 1);
+    EXPECT_EQ(graph.getSize(), 0);
+}
+
+TEST(GraphTest, RowsArePaddedToCacheLines)
+{
+    static constexpr auto order = size_t {19};
+
+    auto weights = tsplib::Graph::WeightBuffer(order * order);
+    for (auto i = size_t {}; i < weights.size(); i++)
+    {
+        weights[i] = static_cast<tsplib::Graph::Weight>(i);
+    }
+
+    auto graph = tsplib::Graph::fromWeights(std::move(weights), order).value();
+    EXPECT_EQ(tsplib::Graph::paddedStride(order), 32);
+    EXPECT_EQ(graph.getSize(), order * (order - 1));
+
+    for (auto i = tsplib::Graph::Vertex {}; i < order; i++)
+    {
+        const auto row = graph.getRow(i);
+        ASSERT_EQ(row.size(), order);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(row.data()) % 64, 0);
+
+        for (auto j = tsplib::Graph::Vertex {}; j < order; j++)
+        {
+            EXPECT_EQ(row[j], i == j ? tsplib::Graph::INFINITY_WEIGHT : static_cast<tsplib::Graph::Weight>(i * order + j));
+        }
+    }
+
+    graph.setOrder(order + 1);
+    EXPECT_EQ(graph.getSize(), order * (order - 1));
+    EXPECT_EQ(graph.getWeight({order - 1, 0}).value(), (order - 1) * order);
+    EXPECT_FALSE(graph.getWeight({order, 0}).has_value());
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(graph.getRow(order).data()) % 64, 0);
+}
+
+TEST(GraphTest, GrowingParsedMatrixKeepsStrideBounded)
+{
+    auto graph = tsplib::Graph::fromWeights(tsplib::Graph::WeightBuffer(64 * 64, 1), 64).value();
+    ASSERT_EQ(graph.getRow(1).data() - graph.getRow(0).data(), 64);
+
+    static_cast<void>(graph.addVertex());
+    EXPECT_EQ(graph.getOrder(), 65);
+    EXPECT_EQ(graph.getWeight({63, 0}).value(), 1);
+    EXPECT_FALSE(graph.doesExist({64, 0}));
+
+    // The stride grows by an eighth rounded up to a cache line, not twice
+    EXPECT_EQ(graph.getRow(1).data() - graph.getRow(0).data(), 80);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(graph.getRow(64).data()) % 64, 0);
+}
+
+TEST(GraphTest, GrowsVertexByVertex)
+{
+    static constexpr auto order = size_t {70};
+
+    auto graph = tsplib::Graph {};
+    for (auto vertex = tsplib::Graph::Vertex {}; vertex < order; vertex++)
+    {
+        graph.setOrder(vertex + 1);
+        for (auto other = tsplib::Graph::Vertex {}; other < vertex; other++)
+        {
+            ASSERT_TRUE(graph.addEdge({{vertex, other}, static_cast<tsplib::Graph::Weight>(vertex * order + other)}));
+        }
+    }
+
+    EXPECT_EQ(graph.getSize(), order * (order - 1) / 2);
+    for (auto vertex = tsplib::Graph::Vertex {}; vertex < order; vertex++)
+    {
+        const auto row = graph.getRow(vertex);
+        ASSERT_EQ(row.size(), order);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(row.data()) % 64, 0);
+
+        for (auto other = tsplib::Graph::Vertex {}; other < order; other++)
+        {
+            EXPECT_EQ(row[other], other < vertex ? static_cast<tsplib::Graph::Weight>(vertex * order + other) : tsplib::Graph::INFINITY_WEIGHT);
+        }
+    }
+
+    // Shrinking within the stride clears the removed columns, growing again brings no old edges back
+    graph.setOrder(20);
+    EXPECT_EQ(graph.getSize(), 20 * 19 / 2);
+    graph.setOrder(order);
+    EXPECT_EQ(graph.getSize(), 20 * 19 / 2);
+    EXPECT_FALSE(graph.doesExist(tsplib::Graph::Edge {30, 0}));
+    EXPECT_FALSE(graph.doesExist(tsplib::Graph::Edge {30, 20}));
+    EXPECT_EQ(graph.getWeight({19, 18}).value(), 19 * order + 18);
+}
+
+namespace
+{
+
+auto renderTestGraph() -> tsplib::Graph
+{
+    const auto inf = tsplib::Graph::INFINITY_WEIGHT;
+    return tsplib::Graph::fromWeights({0,    -12, 5,
+                                       1000, 0,   inf,
+                                       7,    8,   0}, 3).value();
+}
+
+auto rendered(const tsplib::Graph& graph, const tsplib::RenderWindow& window) -> std::string
+{
+    auto output = std::ostringstream {};
+    graph.render(output, window);
+    return std::move(output).str();
+}
+
+}
+
+TEST(GraphTest, ToString)
+{
+    EXPECT_EQ(renderTestGraph().toString(), "\n"
+                                            "    ║ 0  │ 1  │ 2  │\n"
+                                            "════╬════╪════╪════╡\n"
+                                            " 0  ║inf │-12 │ 5  │\n"
+                                            "────╫────┼────┼────┤\n"
+                                            " 1  ║1000│inf │inf │\n"
+                                            "────╫────┼────┼────┤\n"
+                                            " 2  ║ 7  │ 8  │inf │\n"
+                                            "────╨────┴────┴────┘");
+}
+
+TEST(GraphTest, RenderWindow)
+{
+    const auto graph = renderTestGraph();
+
+    EXPECT_EQ(rendered(graph, {.firstRow = 1, .firstColumn = 2, .rows = 5, .columns = 1}), "   ║ 2 │\n"
+                                                                                       "═══╬═══╡\n"
+                                                                                       " 1 ║inf│\n"
+                                                                                       "───╫───┤\n"
+                                                                                       " 2 ║inf│\n"
+                                                                                       "───╨───┘");
+    EXPECT_EQ(rendered(graph, tsplib::RenderWindow::preview(2)), "    ║ 0  │ 1  │\n"
+                                                                 "════╬════╪════╡\n"
+                                                                 " 0  ║inf │-12 │\n"
+                                                                 "────╫────┼────┤\n"
+                                                                 " 1  ║1000│inf │\n"
+                                                                 "────╨────┴────┘");
+    EXPECT_EQ(rendered(graph, {}), renderTestGraph().toString().substr(1));
+}
+
+TEST(GraphTest, SparseRows)
+{
+    auto graph = tsplib::Graph::fromEdges({{{2, 0}, 7}, {{0, 1}, 3}, {{0, 1}, 4}, {{1, 1}, 5}, {{0, 3}, 1}, {{1, 0}, 2}}, 3);
+
+    EXPECT_EQ(graph.getRepresentation(), tsplib::Graph::Representation::SPARSE_ROWS);
+    EXPECT_EQ(graph.getOrder(), 3);
+    EXPECT_EQ(graph.getSize(), 3);
+    EXPECT_EQ(graph.getWeight({0, 1}).value(), 3);
+    EXPECT_EQ(graph.getWeightUnchecked({2, 0}), 7);
+    EXPECT_EQ(graph.getWeightUnchecked({2, 1}), tsplib::Graph::INFINITY_WEIGHT);
+    EXPECT_FALSE(graph.doesExist(tsplib::Graph::Edge {1, 1}));
+    EXPECT_EQ(graph.getNumberOfNeighboursOf(0), 1);
+    EXPECT_TRUE(graph.getRow(0).empty());
+
+    auto rowBuffer = std::vector<tsplib::Graph::Weight>(3);
+    const auto row = graph.getRow(1, rowBuffer);
+    EXPECT_TRUE(std::ranges::equal(row, std::vector {2, tsplib::Graph::INFINITY_WEIGHT, tsplib::Graph::INFINITY_WEIGHT}));
+
+    EXPECT_TRUE(graph.addEdge({{0, 2}, 9}));
+    EXPECT_FALSE(graph.addEdge({{0, 2}, 10}));
+    EXPECT_TRUE(graph.setWeight({2, 0}, 8));
+    EXPECT_TRUE(graph.removeEdge({0, 1}));
+    EXPECT_FALSE(graph.removeEdge({0, 1}));
+    EXPECT_EQ(graph.getEdges(), (std::vector<tsplib::Graph::EdgeData> {{{0, 2}, 9}, {{1, 0}, 2}, {{2, 0}, 8}}));
+
+    graph.setOrder(4);
+    EXPECT_EQ(graph.getSize(), 3);
+    EXPECT_TRUE(graph.addEdge({{3, 1}, 6}));
+    EXPECT_EQ(graph.getNeighboursOf(3)->front().vertex, 1);
+
+    graph.setOrder(2);
+    EXPECT_EQ(graph.getRepresentation(), tsplib::Graph::Representation::SPARSE_ROWS);
+    EXPECT_EQ(graph.getEdges(), (std::vector<tsplib::Graph::EdgeData> {{{1, 0}, 2}}));
+}
+
+TEST(GraphTest, SparseRowsRenderLikeDenseMatrix)
+{
+    const auto dense = renderTestGraph();
+    const auto sparse = tsplib::Graph::fromEdges(dense.getEdges(), dense.getOrder());
+
+    EXPECT_EQ(sparse.getEdges(), dense.getEdges());
+    EXPECT_EQ(sparse.toString(), dense.toString());
+}
+
+TEST(GraphTest, InfinityWeightOfEveryType)
+{
+    EXPECT_EQ(tsplib::BasicGraph<int16_t>::INFINITY_WEIGHT, std::numeric_limits<int16_t>::max());
+    EXPECT_EQ(tsplib::BasicGraph<int32_t>::INFINITY_WEIGHT, std::numeric_limits<int32_t>::max());
+    EXPECT_EQ(tsplib::BasicGraph<float>::INFINITY_WEIGHT, std::numeric_limits<float>::infinity());
+
+    auto graph = tsplib::BasicGraph<float>::fromWeights({0.0f, 0.5f,
+                                                         std::numeric_limits<float>::infinity(), 0.0f}, 2).value();
+    EXPECT_EQ(graph.getSize(), 1);
+    EXPECT_EQ(graph.getWeight({0, 1}).value(), 0.5f);
+    EXPECT_FALSE(graph.doesExist(tsplib::BasicGraph<float>::Edge {1, 0}));
+    EXPECT_EQ(tsplib::BasicGraph<int16_t>::paddedStride(3), 32);
+    EXPECT_EQ(tsplib::BasicGraph<float>::paddedStride(3), 16);
+
+    EXPECT_TRUE(graph.addEdge({{1, 0}, -1.25f}));
+    EXPECT_EQ(graph.getWeightUnchecked({1, 0}), -1.25f);
+
+    auto output = std::ostringstream {};
+    graph.render(output, tsplib::RenderWindow {.firstRow = 1, .rows = 1});
+    EXPECT_NE(output.str().find("  1  ║-1.25│ inf │"), std::string::npos) << output.str();
+}
+
+TEST(GraphTest, ConvertGraph)
+{
+    const auto inf = tsplib::Graph::INFINITY_WEIGHT;
+    const auto graph = tsplib::Graph::fromWeights({0,      32766, -32768,
+                                                   inf,    0,     7,
+                                                   1,      2,     0}, 3).value();
+
+    const auto narrow = tsplib::convertGraph<int16_t>(graph);
+    ASSERT_TRUE(narrow.has_value());
+    EXPECT_EQ(narrow->getSize(), graph.getSize());
+    EXPECT_EQ(narrow->getWeight({0, 1}).value(), 32766);
+    EXPECT_EQ(narrow->getWeight({0, 2}).value(), -32768);
+    EXPECT_EQ(narrow->getWeightUnchecked({1, 0}), tsplib::BasicGraph<int16_t>::INFINITY_WEIGHT);
+
+    const auto real = tsplib::convertGraph<float>(graph);
+    ASSERT_TRUE(real.has_value());
+    EXPECT_EQ(real->getWeightUnchecked({1, 0}), std::numeric_limits<float>::infinity());
+    EXPECT_EQ(tsplib::convertGraph<int32_t>(real.value())->getEdges(), graph.getEdges());
+
+    // 32767 is the infinity of 16 bit weights, 2^24 + 1 has no float
+    auto wide = graph;
+    ASSERT_TRUE(wide.setWeight({1, 2}, 32767));
+    EXPECT_FALSE(tsplib::convertGraph<int16_t>(wide).has_value());
+    ASSERT_TRUE(wide.setWeight({1, 2}, (1 << 24) + 1));
+    EXPECT_FALSE(tsplib::convertGraph<float>(wide).has_value());
+    EXPECT_FALSE(tsplib::convertGraph<int16_t>(tsplib::BasicGraph<float>::fromEdges({{{0, 1}, 0.5f}}, 2)).has_value());
+
+    const auto sparse = tsplib::convertGraph<int16_t>(tsplib::Graph::fromEdges(graph.getEdges(), 3));
+    ASSERT_TRUE(sparse.has_value());
+    EXPECT_EQ(sparse->getRepresentation(), tsplib::GraphRepresentation::SPARSE_ROWS);
+    EXPECT_EQ(sparse->toString(), narrow->toString());
+
+    const auto symmetric = tsplib::Graph::fromSymmetricWeights({5, 7, inf}, 3).value();
+    const auto packed = tsplib::convertGraph<float>(symmetric);
+    ASSERT_TRUE(packed.has_value());
+    EXPECT_EQ(packed->getRepresentation(), tsplib::GraphRepresentation::PACKED_SYMMETRIC);
+    EXPECT_EQ(packed->getSize(), symmetric.getSize());
+    EXPECT_EQ(packed->getWeight({2, 0}).value(), 7.0f);
+    EXPECT_EQ(packed->getWeight({0, 2}).value(), 7.0f);
+    EXPECT_FALSE(packed->doesExist({1, 2}));
+}
+
+TEST(GraphTest, PackedSymmetric)
+{
+    const auto inf = tsplib::Graph::INFINITY_WEIGHT;
+    auto graph = tsplib::Graph::fromWeights({0, 1,   2,
+                                             1, 0,   inf,
+                                             2, inf, 0}, 3, true).value();
+
+    EXPECT_EQ(graph.getRepresentation(), tsplib::Graph::Representation::PACKED_SYMMETRIC);
+    EXPECT_EQ(graph.getSize(), 4);
+    EXPECT_EQ(graph.getWeight({2, 0}).value(), 2);
+    EXPECT_EQ(graph.getWeightUnchecked({0, 2}), 2);
+    EXPECT_EQ(graph.getWeightUnchecked({1, 1}), inf);
+    EXPECT_FALSE(graph.getWeight({1, 2}).has_value());
+    EXPECT_EQ(graph.getNumberOfNeighboursOf(0), 2);
+    EXPECT_TRUE(graph.getRow(0).empty());
+
+    auto rowBuffer = std::vector<tsplib::Graph::Weight>(3);
+    EXPECT_TRUE(std::ranges::equal(graph.getRow(1, rowBuffer), std::vector {1, inf, inf}));
+
+    EXPECT_TRUE(graph.setWeight({0, 1}, 1));
+    EXPECT_EQ(graph.getRepresentation(), tsplib::Graph::Representation::PACKED_SYMMETRIC);
+
+    graph.setOrder(4);
+    EXPECT_EQ(graph.getSize(), 4);
+    EXPECT_FALSE(graph.doesExist(tsplib::Graph::Edge {3, 0}));
+
+    graph.setOrder(2);
+    EXPECT_EQ(graph.getRepresentation(), tsplib::Graph::Representation::PACKED_SYMMETRIC);
+    EXPECT_EQ(graph.getEdges(), (std::vector<tsplib::Graph::EdgeData> {{{0, 1}, 1}, {{1, 0}, 1}}));
+
+    EXPECT_EQ(tsplib::Graph::fromWeights({0, 1, 1, 0}, 2)->getRepresentation(), tsplib::Graph::Representation::DENSE_MATRIX);
+    EXPECT_FALSE(tsplib::Graph::fromSymmetricWeights({1, 2}, 3).has_value());
+}
+
+TEST(GraphTest, PackedSymmetricUnpacksOnOneDirectionalWrites)
+{
+    const auto inf = tsplib::Graph::INFINITY_WEIGHT;
+    const auto symmetric = tsplib::Graph::fromWeights({0, 1,   2,
+                                                       1, 0,   inf,
+                                                       2, inf, 0}, 3, true).value();
+
+    auto reweighted = symmetric;
+    EXPECT_TRUE(reweighted.setWeight({0, 1}, 100));
+    EXPECT_EQ(reweighted.getRepresentation(), tsplib::Graph::Representation::DENSE_MATRIX);
+    EXPECT_EQ(reweighted.getWeight({0, 1}).value(), 100);
+    EXPECT_EQ(reweighted.getWeight({1, 0}).value(), 1);
+    EXPECT_EQ(reweighted.getSize(), 4);
+
+    auto removed = symmetric;
+    EXPECT_TRUE(removed.removeEdge({2, 0}));
+    EXPECT_EQ(removed.getRepresentation(), tsplib::Graph::Representation::DENSE_MATRIX);
+    EXPECT_EQ(removed.getWeight({0, 2}).value(), 2);
+    EXPECT_EQ(removed.getSize(), 3);
+
+    auto added = symmetric;
+    EXPECT_TRUE(added.addEdge({{2, 1}, 7}));
+    EXPECT_EQ(added.getRepresentation(), tsplib::Graph::Representation::DENSE_MATRIX);
+    EXPECT_FALSE(added.doesExist(tsplib::Graph::Edge {1, 2}));
+    EXPECT_EQ(added.getEdges(), (std::vector<tsplib::Graph::EdgeData> {{{0, 1}, 1}, {{0, 2}, 2}, {{1, 0}, 1}, {{2, 0}, 2}, {{2, 1}, 7}}));
+}
+
+TEST(GraphTest, PackedSymmetricRendersLikeDenseMatrix)
+{
+    auto dense = tsplib::Graph {4};
+    for (const auto& [edge, weight] : std::vector<tsplib::Graph::EdgeData> {{{0, 1}, 3}, {{0, 3}, -12}, {{2, 3}, 100}})
+    {
+        ASSERT_TRUE(dense.addEdge({edge, weight}));
+        ASSERT_TRUE(dense.addEdge({{edge.second, edge.first}, weight}));
+    }
+
+    auto weights = tsplib::Graph::WeightBuffer(16);
+    for (auto vertex = tsplib::Graph::Vertex {}; vertex < 4; vertex++)
+    {
+        std::ranges::copy(dense.getRow(vertex), weights.begin() + static_cast<std::ptrdiff_t>(vertex * 4));
+    }
+
+    const auto packed = tsplib::Graph::fromWeights(std::move(weights), 4, true).value();
+    ASSERT_EQ(packed.getRepresentation(), tsplib::Graph::Representation::PACKED_SYMMETRIC);
+    EXPECT_EQ(packed.getEdges(), dense.getEdges());
+    EXPECT_EQ(packed.toString(), dense.toString());
+}
+
+template<typename W>
+auto checkSymmetryDetection() -> void
+{
+    using Graph = tsplib::BasicGraph<W>;
+
+    // Orders around the block size of the vectorized check, with one mismatch anywhere below the diagonal
+    for (const auto order : {size_t {7}, size_t {8}, size_t {17}, size_t {24}})
+    {
+        auto symmetric = typename Graph::WeightBuffer(order * order);
+        for (auto i = size_t {}; i < order; i++)
+        {
+            for (auto j = size_t {}; j < order; j++)
+            {
+                symmetric[i * order + j] = static_cast<W>((i + 1) * (j + 1) % 97) - W {40};
+            }
+        }
+
+        EXPECT_EQ(Graph::fromWeights(symmetric, order, true)->getRepresentation(), tsplib::GraphRepresentation::PACKED_SYMMETRIC);
+
+        for (auto i = size_t {1}; i < order; i++)
+        {
+            for (auto j = size_t {}; j < i; j++)
+            {
+                auto asymmetric = symmetric;
+                asymmetric[i * order + j] += W {1};
+
+                const auto graph = Graph::fromWeights(std::move(asymmetric), order, true);
+                ASSERT_EQ(graph->getRepresentation(), tsplib::GraphRepresentation::DENSE_MATRIX) << order << ' ' << i << ' ' << j;
+                EXPECT_EQ(graph->getWeightUnchecked({j, i}) + W {1}, graph->getWeightUnchecked({i, j}));
+            }
+        }
+    }
+}
+
+TEST(GraphTest, SymmetryDetection)
+{
+    checkSymmetryDetection<int16_t>();
+    checkSymmetryDetection<int32_t>();
+    checkSymmetryDetection<float>();
+}
+
+TEST(GraphTest, VisitorsStopEarly)
+{
+    const auto inf = tsplib::Graph::INFINITY_WEIGHT;
+    const auto dense = tsplib::Graph::fromWeights({0,   1, 2,   3,
+                                                   4,   0, inf, 6,
+                                                   7,   8, 0,   9,
+                                                   inf, 5, 1,   0}, 4).value();
+    const auto sparse = tsplib::Graph::fromEdges(dense.getEdges(), 4);
+    const auto packed = tsplib::Graph::fromWeights({0, 1,   2,   3,
+                                                    1, 0,   inf, 6,
+                                                    2, inf, 0,   9,
+                                                    3, 6,   9,   0}, 4, true).value();
+
+    for (const auto* graph : {&dense, &sparse, &packed})
+    {
+        auto visited = std::vector<tsplib::Graph::EdgeData> {};
+        EXPECT_TRUE(graph->forEachEdge([&visited](const tsplib::Graph::EdgeData& edge) { visited.push_back(edge); }));
+        EXPECT_EQ(visited, graph->getEdges());
+
+        auto untilHeavyEdge = std::vector<tsplib::Graph::EdgeData> {};
+        EXPECT_FALSE(graph->forEachEdge([&untilHeavyEdge](const tsplib::Graph::EdgeData& edge) {
+            untilHeavyEdge.push_back(edge);
+            return edge.weight < 6;
+        }));
+        ASSERT_FALSE(untilHeavyEdge.empty());
+        EXPECT_EQ(untilHeavyEdge.back().weight, 6);
+        EXPECT_TRUE(std::ranges::equal(untilHeavyEdge, visited | std::views::take(untilHeavyEdge.size())));
+
+        for (auto vertex = tsplib::Graph::Vertex {}; vertex < 4; vertex++)
+        {
+            auto neighbours = std::vector<tsplib::Graph::Vertex> {};
+            EXPECT_TRUE(graph->forEachNeighbourOf(vertex, [&neighbours](tsplib::Graph::Neighbour neighbour) {
+                neighbours.push_back(neighbour.vertex);
+                return true;
+            }));
+            EXPECT_EQ(neighbours.size(), graph->getNumberOfNeighboursOf(vertex));
+        }
+
+        auto firstNeighbour = std::optional<tsplib::Graph::Vertex> {};
+        EXPECT_FALSE(graph->forEachNeighbourOf(3, [&firstNeighbour](tsplib::Graph::Neighbour neighbour) {
+            firstNeighbour = neighbour.vertex;
+            return false;
+        }));
+        EXPECT_EQ(firstNeighbour, graph->getNeighboursOf(3)->front().vertex);
+    }
+
+    auto vertices = size_t {};
+    EXPECT_FALSE(dense.forEachVertex([&vertices](tsplib::Graph::Vertex vertex) {
+        vertices++;
+        return vertex != 1;
+    }));
+    EXPECT_EQ(vertices, 2);
+
+    // The std::function overloads are still there
+    auto edges = size_t {};
+    const auto countEdges = tsplib::Graph::EdgePredicate {[&edges](const tsplib::Graph::EdgeData&) { edges++; }};
+    dense.forEachEdge(countEdges);
+    EXPECT_EQ(edges, dense.getSize());
+}
+
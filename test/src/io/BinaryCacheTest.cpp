@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include "io/BinaryCache.h"
+
+#include <array>
+#include <cstring>
+#include <sstream>
+
+namespace
+{
+
+auto makeContent() -> tsplib::Content
+{
+    auto graph = tsplib::Graph::fromWeights({0, 1, 2,
+                                             3, 0, 5,
+                                             6, tsplib::Graph::INFINITY_WEIGHT, 0}, 3);
+
+    return {
+        .metaData = {
+            .name = "cached",
+            .comment = {},
+            .type = tsplib::Type::ATSP,
+            .dimension = 3
+        },
+        .graph = std::move(graph.value()),
+        .coordinates = std::vector<tsplib::Point3d> {{1, 0.5, 1.5, -2.0}, {2, 3.0, 4.0, 5.0}, {3, 1e10, -1e-10, 0.0}}
+    };
+}
+
+auto serialized(const tsplib::Content& content, uint64_t sourceHash) -> std::string
+{
+    auto output = std::ostringstream {};
+    EXPECT_TRUE(tsplib::writeCache(output, content, sourceHash));
+    return std::move(output).str();
+}
+
+}
+
+TEST(BinaryCacheTest, ContentHash)
+{
+    EXPECT_EQ(tsplib::contentHash("NAME: a\nDIMENSION: 3\n"), tsplib::contentHash("NAME: a\nDIMENSION: 3\n"));
+    EXPECT_NE(tsplib::contentHash("NAME: a\nDIMENSION: 3\n"), tsplib::contentHash("NAME: a\nDIMENSION: 4\n"));
+    EXPECT_NE(tsplib::contentHash("12345678"), tsplib::contentHash("12345678 "));
+    EXPECT_NE(tsplib::contentHash(""), tsplib::contentHash(std::string_view {"\0", 1}));
+}
+
+TEST(BinaryCacheTest, RoundTrip)
+{
+    const auto content = makeContent();
+    const auto bytes = serialized(content, 42);
+    const auto layout = tsplib::readCache(bytes);
+
+    ASSERT_NO_THROW(layout.value());
+    EXPECT_EQ(layout->sourceHash, 42);
+    EXPECT_EQ(layout->representation, tsplib::GraphRepresentation::DENSE_MATRIX);
+    EXPECT_EQ(layout->order, 3);
+    EXPECT_EQ(layout->size, content.graph.getSize());
+    EXPECT_EQ(layout->weightsOffset % 64, 0);
+    EXPECT_EQ(layout->metaData.name.value(), "cached");
+    EXPECT_FALSE(layout->metaData.comment.has_value());
+    EXPECT_EQ(layout->metaData.type.value(), tsplib::Type::ATSP);
+    EXPECT_EQ(layout->metaData.dimension.value(), 3);
+
+    const auto& points = std::get<std::vector<tsplib::Point3d>>(layout->coordinates.value());
+    ASSERT_EQ(points.size(), 3);
+    EXPECT_EQ(points[0].id, 1);
+    EXPECT_EQ(points[0].z, -2.0);
+    EXPECT_EQ(points[2].x, 1e10);
+    EXPECT_EQ(points[2].y, -1e-10);
+
+    ASSERT_EQ(bytes.size(), layout->weightsOffset + 9 * sizeof(tsplib::Graph::Weight));
+    for (auto vertex = tsplib::Graph::Vertex {}; vertex < 3; vertex++)
+    {
+        const auto row = content.graph.getRow(vertex);
+        EXPECT_EQ(std::memcmp(bytes.data() + layout->weightsOffset + vertex * row.size_bytes(), row.data(), row.size_bytes()), 0);
+    }
+}
+
+TEST(BinaryCacheTest, SparseAndPackedGraphsAreStoredAsTheyAre)
+{
+    auto content = makeContent();
+    content.coordinates.reset();
+
+    // A dense matrix of this order would take 4 MB
+    content.graph = tsplib::Graph::fromEdges({{{0, 999}, 5}, {{999, 0}, 6}, {{500, 1}, 7}}, 1000);
+    const auto sparseBytes = serialized(content, 1);
+    const auto sparse = tsplib::readCache(sparseBytes);
+
+    ASSERT_NO_THROW(sparse.value());
+    EXPECT_EQ(sparse->representation, tsplib::GraphRepresentation::SPARSE_ROWS);
+    EXPECT_EQ(sparse->order, 1000);
+    EXPECT_EQ(sparse->weightsCount, 3);
+    EXPECT_LT(sparseBytes.size(), 10000);
+
+    auto column = tsplib::Graph::Vertex {};
+    std::memcpy(&column, sparseBytes.data() + sparse->columnsOffset + 2 * sizeof(column), sizeof(column));
+    EXPECT_EQ(column, 0);
+
+    auto outOfRange = sparseBytes;
+    column = 1000;
+    std::memcpy(outOfRange.data() + sparse->columnsOffset, &column, sizeof(column));
+    EXPECT_FALSE(tsplib::readCache(outOfRange).has_value());
+
+    content.graph = tsplib::Graph::fromSymmetricWeights({1, 2, 3}, 3).value();
+    const auto packedBytes = serialized(content, 1);
+    const auto packed = tsplib::readCache(packedBytes);
+
+    ASSERT_NO_THROW(packed.value());
+    EXPECT_EQ(packed->representation, tsplib::GraphRepresentation::PACKED_SYMMETRIC);
+    EXPECT_EQ(packed->weightsCount, 3);
+    ASSERT_EQ(packedBytes.size(), packed->weightsOffset + 3 * sizeof(tsplib::Graph::Weight));
+
+    auto weights = std::array<tsplib::Graph::Weight, 3> {};
+    std::memcpy(weights.data(), packedBytes.data() + packed->weightsOffset, sizeof(weights));
+    EXPECT_EQ(weights, (std::array<tsplib::Graph::Weight, 3> {1, 2, 3}));
+}
+
+TEST(BinaryCacheTest, WithoutCoordinates)
+{
+    auto content = makeContent();
+    content.coordinates.reset();
+
+    const auto layout = tsplib::readCache(serialized(content, 7));
+
+    ASSERT_NO_THROW(layout.value());
+    EXPECT_FALSE(layout->coordinates.has_value());
+    EXPECT_EQ(layout->order, 3);
+}
+
+TEST(BinaryCacheTest, RejectsOtherData)
+{
+    const auto bytes = serialized(makeContent(), 42);
+
+    EXPECT_FALSE(tsplib::readCache("").has_value());
+    EXPECT_FALSE(tsplib::readCache("NAME: br17\nEOF\n").has_value());
+    EXPECT_FALSE(tsplib::readCache(std::string_view {bytes}.substr(0, bytes.size() - 1)).has_value());
+    EXPECT_FALSE(tsplib::readCache(bytes + '\0').has_value());
+
+    auto otherVersion = bytes;
+    otherVersion[8] = static_cast<char>(tsplib::CACHE_VERSION + 1);
+    EXPECT_FALSE(tsplib::readCache(otherVersion).has_value());
+
+    auto hugeOrder = bytes;
+    std::memset(hugeOrder.data() + 24, 0xFF, sizeof(uint64_t));
+    EXPECT_FALSE(tsplib::readCache(hugeOrder).has_value());
+}
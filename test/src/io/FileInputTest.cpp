@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include "io/FileInput.h"
+
+#include <fstream>
+#include <thread>
+
+#ifdef TSPLIB_HAS_MMAP
+#include <sys/stat.h>
+#endif
+
+TEST(FileInputTest, RegularFile)
+{
+    const auto path = std::filesystem::temp_directory_path() / "tsp_reader_file_input.txt";
+    {
+        auto file = std::ofstream {path, std::ios::binary};
+        file << "NAME: test\r\nEOF";
+    }
+
+    const auto input = tsplib::FileInput::open(path);
+    std::filesystem::remove(path);
+
+    ASSERT_NO_THROW(input.value());
+    EXPECT_EQ(input->getContent(), "NAME: test\r\nEOF");
+#ifdef TSPLIB_HAS_MMAP
+    EXPECT_TRUE(input->isMapped());
+#endif
+}
+
+TEST(FileInputTest, EmptyFile)
+{
+    const auto path = std::filesystem::temp_directory_path() / "tsp_reader_file_input_empty.txt";
+    std::ofstream {path};
+
+    const auto input = tsplib::FileInput::open(path);
+    std::filesystem::remove(path);
+
+    ASSERT_NO_THROW(input.value());
+    EXPECT_EQ(input->getContent(), "");
+}
+
+TEST(FileInputTest, MissingFile)
+{
+    EXPECT_FALSE(tsplib::FileInput::open(std::filesystem::temp_directory_path() / "tsp_reader_missing").has_value());
+}
+
+#ifdef TSPLIB_HAS_MMAP
+
+TEST(FileInputTest, Pipe)
+{
+    const auto path = std::filesystem::temp_directory_path() / "tsp_reader_file_input.fifo";
+    std::filesystem::remove(path);
+    ASSERT_EQ(::mkfifo(path.c_str(), 0600), 0);
+
+    const auto text = std::string(200000, '7');
+    auto writer = std::jthread {[&path, &text] {
+        auto fifo = std::ofstream {path, std::ios::binary};
+        fifo << text;
+    }};
+
+    const auto input = tsplib::FileInput::open(path);
+    writer.join();
+    std::filesystem::remove(path);
+
+    ASSERT_NO_THROW(input.value());
+    EXPECT_FALSE(input->isMapped());
+    EXPECT_EQ(input->getContent(), text);
+}
+
+#endif
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include "io/GzipInput.h"
+
+#include <string>
+
+#ifdef TSPLIB_HAS_ZLIB
+#include <zlib.h>
+
+namespace
+{
+
+auto gzipped(std::string_view text) -> std::string
+{
+    // 16 added to the window bits writes a gzip header and trailer
+    auto stream = z_stream {};
+    EXPECT_EQ(deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY), Z_OK);
+
+    auto result = std::string(deflateBound(&stream, static_cast<uLong>(text.size())), '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(text.data()));
+    stream.avail_in = static_cast<uInt>(text.size());
+    stream.next_out = reinterpret_cast<Bytef*>(result.data());
+    stream.avail_out = static_cast<uInt>(result.size());
+
+    EXPECT_EQ(deflate(&stream, Z_FINISH), Z_STREAM_END);
+    result.resize(stream.total_out);
+    deflateEnd(&stream);
+
+    return result;
+}
+
+auto gunzipped(std::string_view input) -> std::optional<std::string>
+{
+    auto result = std::string {};
+    const auto isCorrect = tsplib::gunzip(input, [&result](std::span<const char> chunk) {
+        result.append(chunk.data(), chunk.size());
+        return true;
+    });
+
+    if (!isCorrect)
+    {
+        return {};
+    }
+
+    return result;
+}
+
+auto makeText(size_t lines) -> std::string
+{
+    auto result = std::string {};
+    for (auto i = size_t {}; i < lines; i++)
+    {
+        result += std::to_string(i * 7919 % 10007) + ' ' + std::to_string(i) + '\n';
+    }
+    return result;
+}
+
+}
+
+TEST(GzipInputTest, IsGzip)
+{
+    EXPECT_TRUE(tsplib::isGzip(gzipped("NAME: a\n")));
+    EXPECT_FALSE(tsplib::isGzip("NAME: a\n"));
+    EXPECT_FALSE(tsplib::isGzip("\x1F"));
+    EXPECT_FALSE(tsplib::isGzip(""));
+}
+
+TEST(GzipInputTest, RoundTrip)
+{
+    const auto text = makeText(100'000);
+    auto chunks = size_t {};
+
+    const auto result = gunzipped(gzipped(text));
+    EXPECT_TRUE(tsplib::gunzip(gzipped(text), [&chunks](auto) { return ++chunks != 0; }));
+
+    ASSERT_NO_THROW(result.value());
+    EXPECT_EQ(result.value(), text);
+    EXPECT_GT(chunks, 1);
+}
+
+TEST(GzipInputTest, MultipleMembers)
+{
+    const auto first = makeText(1000);
+    const auto second = std::string {"EOF\n"};
+
+    const auto result = gunzipped(gzipped(first) + gzipped(second));
+
+    ASSERT_NO_THROW(result.value());
+    EXPECT_EQ(result.value(), first + second);
+}
+
+TEST(GzipInputTest, BrokenInput)
+{
+    const auto compressed = gzipped(makeText(1000));
+
+    EXPECT_FALSE(gunzipped("").has_value());
+    EXPECT_FALSE(gunzipped("NAME: a\n").has_value());
+    EXPECT_FALSE(gunzipped(std::string_view {compressed}.substr(0, compressed.size() / 2)).has_value());
+    EXPECT_FALSE(gunzipped(std::string_view {compressed}.substr(0, compressed.size() - 1)).has_value());
+
+    auto corrupted = compressed;
+    corrupted[compressed.size() / 2] = static_cast<char>(~corrupted[compressed.size() / 2]);
+    EXPECT_FALSE(gunzipped(corrupted).has_value());
+}
+
+TEST(GzipInputTest, ConsumerStops)
+{
+    auto chunks = size_t {};
+
+    EXPECT_FALSE(tsplib::gunzip(gzipped(makeText(100'000)), [&chunks](auto) { return ++chunks < 2; }));
+    EXPECT_EQ(chunks, 2);
+}
+
+#else
+
+TEST(GzipInputTest, WithoutZlib)
+{
+    EXPECT_FALSE(tsplib::gunzip("\x1F\x8B", [](auto) { return true; }));
+}
+
+#endif
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include "Reader.h"
+#include "Writer.h"
+#include "io/BufferedWriter.h"
+
+#include <sstream>
+
+namespace
+{
+
+constexpr auto INF = tsplib::Graph::INFINITY_WEIGHT;
+
+auto makeContent(tsplib::Graph::WeightBuffer weights, size_t order) -> tsplib::Content
+{
+    return {
+        .metaData = {
+            .name = "written",
+            .comment = "derived instance",
+            .type = tsplib::Type::TSP,
+            .dimension = order
+        },
+        .graph = tsplib::Graph::fromWeights(std::move(weights), order).value(),
+        .coordinates = {}
+    };
+}
+
+auto symmetricContent() -> tsplib::Content
+{
+    return makeContent({0,   1,   2,  3,
+                        1,   0, INF, -5,
+                        2, INF,   0,  7,
+                        3,  -5,   7,  0}, 4);
+}
+
+}
+
+TEST(WriterTest, BufferedWriterFlushesWhenFull)
+{
+    auto output = std::ostringstream {};
+    {
+        auto writer = tsplib::BufferedWriter {output, 1};
+        for (auto i = 0; i < 1000; ++i)
+        {
+            writer.write(i).write(' ').write(-0.25).write("\n");
+        }
+    }
+
+    auto expected = std::string {};
+    for (auto i = 0; i < 1000; ++i)
+    {
+        expected += std::to_string(i) + " -0.25\n";
+    }
+
+    EXPECT_EQ(output.str(), expected);
+}
+
+TEST(WriterTest, FullMatrix)
+{
+    const auto content = makeContent({0, 1, 2,
+                                      3, 0, INF,
+                                      6, 7, 0}, 3);
+
+    EXPECT_EQ(tsplib::tspContentToString(content).value(), "NAME: written\n"
+                                                           "TYPE: TSP\n"
+                                                           "COMMENT: derived instance\n"
+                                                           "DIMENSION: 3\n"
+                                                           "EDGE_WEIGHT_TYPE: EXPLICIT\n"
+                                                           "EDGE_WEIGHT_FORMAT: FULL_MATRIX\n"
+                                                           "EDGE_WEIGHT_SECTION\n"
+                                                           "0 1 2\n"
+                                                           "3 0 2147483647\n"
+                                                           "6 7 0\n"
+                                                           "EOF\n");
+}
+
+TEST(WriterTest, TriangularFormats)
+{
+    using enum tsplib::MatrixFormat;
+
+    const auto content = symmetricContent();
+
+    EXPECT_NE(tsplib::tspContentToString(content, {.format = UPPER_ROW})->find("EDGE_WEIGHT_SECTION\n"
+                                                                                "1 2 3\n"
+                                                                                "2147483647 -5\n"
+                                                                                "7\n"
+                                                                                "EOF\n"),
+              std::string::npos);
+    EXPECT_NE(tsplib::tspContentToString(content, {.format = LOWER_DIAG_ROW})->find("EDGE_WEIGHT_SECTION\n"
+                                                                                     "0\n"
+                                                                                     "1 0\n"
+                                                                                     "2 2147483647 0\n"
+                                                                                     "3 -5 7 0\n"
+                                                                                     "EOF\n"),
+              std::string::npos);
+}
+
+TEST(WriterTest, RoundTripOfEveryFormat)
+{
+    using enum tsplib::MatrixFormat;
+
+    const auto content = symmetricContent();
+
+    for (const auto format : {FULL_MATRIX, UPPER_ROW, LOWER_ROW, UPPER_DIAG_ROW, LOWER_DIAG_ROW,
+                              UPPER_COL, LOWER_COL, UPPER_DIAG_COL, LOWER_DIAG_COL})
+    {
+        const auto text = tsplib::tspContentToString(content, {.format = format});
+        ASSERT_TRUE(text.has_value());
+
+        const auto read = tsplib::getTspContent(text.value());
+        ASSERT_TRUE(read.has_value()) << text.value();
+
+        EXPECT_EQ(read->metaData.name, content.metaData.name);
+        EXPECT_EQ(read->metaData.comment, content.metaData.comment);
+        EXPECT_EQ(read->metaData.type, content.metaData.type);
+        EXPECT_EQ(read->graph.getOrder(), content.graph.getOrder());
+        EXPECT_EQ(read->graph.getEdges(), content.graph.getEdges()) << text.value();
+    }
+}
+
+TEST(WriterTest, TriangularFormatsNeedSymmetricGraph)
+{
+    const auto content = makeContent({0, 1,
+                                      2, 0}, 2);
+
+    EXPECT_TRUE(tsplib::tspContentToString(content).has_value());
+    EXPECT_FALSE(tsplib::tspContentToString(content, {.format = tsplib::MatrixFormat::UPPER_ROW}).has_value());
+}
+
+TEST(WriterTest, Coordinates)
+{
+    auto content = makeContent({0, 1, 1, 0}, 2);
+    content.coordinates = std::vector<tsplib::Point2d> {{1, 0.1, -2.5}, {2, 1e-7, 123456.789}};
+
+    const auto text = tsplib::tspContentToString(content).value();
+    EXPECT_NE(text.find("NODE_COORD_SECTION\n"
+                        "1 0.1 -2.5\n"
+                        "2 1e-07 123456.789\n"), std::string::npos);
+
+    const auto read = tsplib::getTspContent(text);
+    ASSERT_TRUE(read.has_value());
+
+    const auto& points = std::get<std::vector<tsplib::Point2d>>(read->coordinates.value());
+    ASSERT_EQ(points.size(), 2);
+    EXPECT_EQ(points[0].x, 0.1);
+    EXPECT_EQ(points[1].x, 1e-7);
+    EXPECT_EQ(points[1].y, 123456.789);
+}
+
+TEST(WriterTest, Tour)
+{
+    const auto tour = std::vector<tsplib::Graph::Vertex> {2, 0, 1};
+    auto output = std::ostringstream {};
+
+    EXPECT_TRUE(tsplib::writeTspTour(output, tour, "tour"));
+    EXPECT_EQ(output.str(), "NAME: tour\n"
+                            "TYPE: TOUR\n"
+                            "DIMENSION: 3\n"
+                            "TOUR_SECTION\n"
+                            "3\n"
+                            "1\n"
+                            "2\n"
+                            "-1\n"
+                            "EOF\n");
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include "parsers/GraphParser.h"
+
+#include <random>
+
+namespace
+{
+
+auto makeSymmetricMatrix(size_t order) -> tsplib::utils::AlignedVector<int32_t>
+{
+    auto generator = std::mt19937 {7};
+    auto distribution = std::uniform_int_distribution<int32_t> {0, 9999};
+    auto matrix = tsplib::utils::AlignedVector<int32_t>(order * order);
+
+    for (auto i = size_t {}; i < order; i++)
+    {
+        for (auto j = i; j < order; j++)
+        {
+            matrix[i * order + j] = matrix[j * order + i] = distribution(generator);
+        }
+    }
+
+    return matrix;
+}
+
+/**
+ * Lists the matrix the way TSPLIB defines each format, the column-wise ones really column by column
+ */
+auto packMatrix(const tsplib::utils::AlignedVector<int32_t>& matrix, size_t order, tsplib::EdgeWeightFormat format) -> tsplib::utils::AlignedVector<int32_t>
+{
+    using enum tsplib::EdgeWeightFormat;
+
+    if (format == FULL_MATRIX)
+    {
+        return matrix;
+    }
+
+    const auto isColumnWise = format == UPPER_COL || format == LOWER_COL ||
+                              format == UPPER_DIAG_COL || format == LOWER_DIAG_COL;
+    const auto isUpper = format == UPPER_ROW || format == UPPER_COL ||
+                         format == UPPER_DIAG_ROW || format == UPPER_DIAG_COL;
+    const auto hasDiagonal = format == UPPER_DIAG_ROW || format == LOWER_DIAG_ROW ||
+                             format == UPPER_DIAG_COL || format == LOWER_DIAG_COL;
+
+    auto result = tsplib::utils::AlignedVector<int32_t> {};
+
+    for (auto outer = size_t {}; outer < order; outer++)
+    {
+        for (auto inner = size_t {}; inner < order; inner++)
+        {
+            const auto row = isColumnWise ? inner : outer;
+            const auto column = isColumnWise ? outer : inner;
+
+            const auto isStored = (isUpper ? row < column : row > column) || (hasDiagonal && row == column);
+            if (isStored)
+            {
+                result.push_back(matrix[row * order + column]);
+            }
+        }
+    }
+
+    return result;
+}
+
+}
+
+TEST(GraphParserTest, AllExplicitFormats)
+{
+    using enum tsplib::EdgeWeightFormat;
+
+    // Not a multiple of the transposition block size
+    for (const auto order : {size_t {1}, size_t {5}, size_t {131}})
+    {
+        const auto matrix = makeSymmetricMatrix(order);
+
+        for (const auto format : {FULL_MATRIX, UPPER_ROW, LOWER_ROW, UPPER_DIAG_ROW, LOWER_DIAG_ROW,
+                                  UPPER_COL, LOWER_COL, UPPER_DIAG_COL, LOWER_DIAG_COL})
+        {
+            auto packed = packMatrix(matrix, order, format);
+
+            for (const auto dimension : {std::optional<size_t> {order}, std::optional<size_t> {}})
+            {
+                const auto graph = tsplib::makeGraphFromWeights(packed, format, dimension);
+
+                ASSERT_TRUE(graph.has_value()) << "format " << static_cast<int>(format) << ", order " << order;
+                ASSERT_EQ(graph->getOrder(), order);
+                EXPECT_EQ(graph->getSize(), order * (order - 1));
+
+                for (auto i = size_t {}; i < order; i++)
+                {
+                    for (auto j = size_t {}; j < order; j++)
+                    {
+                        const auto expected = i == j ? tsplib::Graph::INFINITY_WEIGHT : matrix[i * order + j];
+                        ASSERT_EQ(graph->getWeightUnchecked({i, j}), expected)
+                            << "format " << static_cast<int>(format) << ", order " << order << ", edge " << i << ' ' << j;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(GraphParserTest, WrongNumberOfWeights)
+{
+    using enum tsplib::EdgeWeightFormat;
+
+    EXPECT_FALSE(tsplib::makeGraphFromWeights({1, 2, 3, 4}, UPPER_ROW).has_value());
+    EXPECT_FALSE(tsplib::makeGraphFromWeights({1, 2, 3}, UPPER_ROW, 4).has_value());
+    EXPECT_FALSE(tsplib::makeGraphFromWeights({1, 2, 3, 4}, FULL_MATRIX, 3).has_value());
+    EXPECT_FALSE(tsplib::makeGraphFromWeights({1, 2, 3}, FUNCTION).has_value());
+}
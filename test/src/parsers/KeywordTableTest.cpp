@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+
+#include "parsers/KeywordTable.h"
+
+namespace
+{
+
+using namespace std::string_view_literals;
+
+constexpr auto colors = tsplib::KeywordTable {std::array {
+    tsplib::Keyword {"RED"sv,   1},
+    tsplib::Keyword {"GREEN"sv, 2},
+    tsplib::Keyword {"BLUE"sv,  3}
+}};
+
+static_assert(colors.isPerfect());
+static_assert(colors.find("GREEN").value() == 2);
+static_assert(!colors.find("YELLOW").has_value());
+
+}
+
+TEST(KeywordTableTest, Find)
+{
+    EXPECT_EQ(colors.find("RED").value(), 1);
+    EXPECT_EQ(colors.find("BLUE").value(), 3);
+    EXPECT_FALSE(colors.find("").has_value());
+    EXPECT_FALSE(colors.find("RE").has_value());
+    EXPECT_FALSE(colors.find("REDS").has_value());
+}
+
+TEST(KeywordTableTest, KeywordParser)
+{
+    const auto result = tsplib::keyword(colors)("BLUE \nRED");
+
+    ASSERT_NO_THROW(result.value());
+    EXPECT_EQ(result->first, 3);
+    EXPECT_EQ(result->second, " \nRED");
+
+    EXPECT_FALSE(tsplib::keyword(colors)("BLUEISH").has_value());
+}
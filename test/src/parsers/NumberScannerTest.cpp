@@ -0,0 +1,223 @@
+#include <gtest/gtest.h>
+
+#include "parsers/NumberScanner.h"
+
+#include <algorithm>
+#include <random>
+
+namespace
+{
+
+auto expectSameAsCombinator(std::string_view input) -> void
+{
+    const auto expected = fp::some(fp::tokenLeft(fp::integer<int32_t>))(input);
+    const auto actual = tsplib::integers(input);
+
+    ASSERT_EQ(expected.has_value(), actual.has_value()) << input;
+
+    if (expected)
+    {
+        EXPECT_TRUE(std::ranges::equal(expected->first, actual->first)) << input;
+        EXPECT_EQ(expected->second, actual->second) << input;
+    }
+}
+
+}
+
+TEST(NumberScannerTest, CharClass)
+{
+    EXPECT_EQ(tsplib::charClassOf('0'), tsplib::CharClass::DIGIT);
+    EXPECT_EQ(tsplib::charClassOf('9'), tsplib::CharClass::DIGIT);
+    EXPECT_EQ(tsplib::charClassOf('-'), tsplib::CharClass::MINUS);
+    EXPECT_EQ(tsplib::charClassOf('\r'), tsplib::CharClass::WHITESPACE);
+    EXPECT_EQ(tsplib::charClassOf('\v'), tsplib::CharClass::WHITESPACE);
+    EXPECT_EQ(tsplib::charClassOf('E'), tsplib::CharClass::OTHER);
+    EXPECT_EQ(tsplib::charClassOf('\xFF'), tsplib::CharClass::OTHER);
+}
+
+TEST(NumberScannerTest, Integers)
+{
+    const auto result = tsplib::integers(" 1 -2\r\n  30\t4\nEOF");
+    ASSERT_NO_THROW(result.value());
+    EXPECT_EQ(result->first, (tsplib::utils::AlignedVector<int32_t> {1, -2, 30, 4}));
+    EXPECT_EQ(result->second, "\nEOF");
+
+    ASSERT_THROW(tsplib::integers("\nEOF").value(), std::bad_optional_access);
+    ASSERT_THROW(tsplib::integers("").value(), std::bad_optional_access);
+}
+
+TEST(NumberScannerTest, SameAsCombinator)
+{
+    expectSameAsCombinator("1 2 3");
+    expectSameAsCombinator("\n 9999    3\r\n    5\r\nEOF");
+    expectSameAsCombinator("1 2 -1\n-1\n");
+    expectSameAsCombinator("12abc 4");
+    expectSameAsCombinator("5-3 - 4");
+    expectSameAsCombinator("1 - 2");
+    expectSameAsCombinator("--1");
+    expectSameAsCombinator("2147483647 -2147483648 1");
+    expectSameAsCombinator("7 2147483648 1");
+    expectSameAsCombinator("7 -2147483649 1");
+    expectSameAsCombinator("0007 00 -0");
+    expectSameAsCombinator("1 +2");
+    expectSameAsCombinator("1.5 2");
+    expectSameAsCombinator("  ");
+    expectSameAsCombinator("x");
+}
+
+TEST(NumberScannerTest, Avx2SameAsScalar)
+{
+#ifdef TSPLIB_AVX2_DISPATCH
+    if (!tsplib::detail::isAvx2Supported())
+    {
+        GTEST_SKIP() << "AVX2 is not supported";
+    }
+
+    static constexpr auto tokens = std::array {
+        "0", "7", "-7", "12345678", "-12345678", "123456789", "-2147483648", "2147483647", "2147483648",
+        "00000000001", "-", "--3", "5-3", "12abc", "EOF", "-0", "99999999", "1234567890123456789012345678901234"
+    };
+    static constexpr auto separators = std::array {" ", "  ", "\n", "\r\n", "\t", "   \r\n  "};
+
+    auto random = std::mt19937 {42};
+    for (auto test = 0; test < 2000; test++)
+    {
+        auto input = std::string {};
+        const auto count = random() % 64;
+        for (auto i = 0u; i < count; i++)
+        {
+            input += separators[random() % separators.size()];
+            // Valid numbers are much more frequent, so the scan usually goes past several windows
+            input += random() % 8 == 0 ? tokens[random() % tokens.size()] : std::to_string(
+                static_cast<int32_t>(random() % 2000001) - 1000000);
+        }
+
+        auto scalar = tsplib::utils::AlignedVector<int32_t> {};
+        auto avx2 = tsplib::utils::AlignedVector<int32_t> {};
+        const auto scalarRest = tsplib::detail::appendIntegersScalar(input, scalar);
+        const auto avx2Rest = tsplib::detail::appendIntegersAvx2(input, avx2);
+
+        ASSERT_EQ(scalar, avx2) << input;
+        ASSERT_EQ(scalarRest, avx2Rest) << input;
+        expectSameAsCombinator(input);
+    }
+#else
+    GTEST_SKIP() << "AVX2 dispatch is not compiled in";
+#endif
+}
+
+TEST(NumberScannerTest, ParallelSameAsSequential)
+{
+    auto random = std::mt19937 {7};
+    auto matrix = std::string {};
+    for (auto i = 0; i < 20000; i++)
+    {
+        matrix += std::to_string(static_cast<int32_t>(random() % 200001) - 100000);
+        matrix += i % 17 == 16 ? "\r\n" : "  ";
+    }
+
+    const auto inputs = std::array {
+        matrix + "EOF",
+        matrix,
+        matrix.substr(0, matrix.size() / 2) + " 12abc " + matrix,
+        matrix.substr(0, matrix.size() / 3) + " - " + matrix,
+        matrix.substr(0, matrix.size() / 3) + " 99999999999 " + matrix,
+        std::string(50000, ' ') + matrix + "-EOF",
+        std::string(50000, '\n') + "EOF"
+    };
+
+    for (const auto& input : inputs)
+    {
+        // Integers are appended after whatever the output holds
+        auto expected = tsplib::utils::AlignedVector<int32_t> {42};
+        const auto expectedRest = tsplib::appendIntegers(input, expected);
+
+        for (const auto threads : {2u, 3u, 8u, 64u})
+        {
+            auto actual = tsplib::utils::AlignedVector<int32_t> {42};
+            const auto actualRest = tsplib::detail::integersParallel(input, threads, 1000, actual);
+
+            EXPECT_EQ(expected, actual);
+            EXPECT_EQ(expectedRest.data(), actualRest.data());
+            EXPECT_EQ(expectedRest.size(), actualRest.size());
+        }
+    }
+}
+
+
+TEST(NumberScannerTest, Real)
+{
+    EXPECT_DOUBLE_EQ(tsplib::real("11abc")->first, 11.0);
+    EXPECT_EQ(tsplib::real("11abc")->second, "abc");
+    EXPECT_DOUBLE_EQ(tsplib::real("-.234 ")->first, -.234);
+    EXPECT_DOUBLE_EQ(tsplib::real("+3.")->first, 3.0);
+    EXPECT_DOUBLE_EQ(tsplib::real("1.5e+06\n")->first, 1.5e6);
+    EXPECT_DOUBLE_EQ(tsplib::real("2E-2")->first, 0.02);
+
+    EXPECT_DOUBLE_EQ(tsplib::real("7e")->first, 7.0);
+    EXPECT_EQ(tsplib::real("7e")->second, "e");
+
+    EXPECT_FALSE(tsplib::real("").has_value());
+    EXPECT_FALSE(tsplib::real("-").has_value());
+    EXPECT_FALSE(tsplib::real(".e5").has_value());
+    EXPECT_FALSE(tsplib::real(" 1").has_value());
+    EXPECT_FALSE(tsplib::real("1e999").has_value());
+}
+
+TEST(NumberScannerTest, SaturatedIntegers)
+{
+    auto small = tsplib::utils::AlignedVector<int16_t> {};
+    const auto rest = tsplib::appendIntegers("1 -32768 32766 32767 40000 -40000 EOF", small, 1);
+
+    EXPECT_EQ(small, (tsplib::utils::AlignedVector<int16_t> {1, -32768, 32766, 32767, 32767, 32767}));
+    EXPECT_EQ(rest, " EOF");
+
+    // Large enough to be split between the threads
+    auto random = std::mt19937 {11};
+    auto input = std::string {};
+    for (auto i = 0; i < 400000; i++)
+    {
+        input += std::to_string(static_cast<int32_t>(random() % 100001) - 50000) + ' ';
+    }
+    input += "EOF";
+
+    auto wide = tsplib::utils::AlignedVector<int32_t> {};
+    static_cast<void>(tsplib::appendIntegers(input, wide));
+
+    auto narrow = tsplib::utils::AlignedVector<int16_t> {};
+    static_cast<void>(tsplib::appendIntegers(input, narrow, 4));
+
+    ASSERT_EQ(narrow.size(), wide.size());
+    for (auto i = size_t {}; i < wide.size(); i++)
+    {
+        const auto fits = wide[i] >= -32768 && wide[i] < 32767;
+        EXPECT_EQ(narrow[i], fits ? wide[i] : 32767) << i;
+    }
+}
+
+TEST(NumberScannerTest, Reals)
+{
+    auto small = tsplib::utils::AlignedVector<float> {0.5f};
+    const auto rest = tsplib::appendReals("1.5 -2\n.25\t1e3 12abc", small, 1);
+
+    EXPECT_EQ(small, (tsplib::utils::AlignedVector<float> {0.5f, 1.5f, -2.0f, 0.25f, 1000.0f, 12.0f}));
+    EXPECT_EQ(rest, "abc");
+
+    auto random = std::mt19937 {13};
+    auto input = std::string {};
+    for (auto i = 0; i < 300000; i++)
+    {
+        input += std::to_string(static_cast<int32_t>(random() % 100000)) + '.' + std::to_string(random() % 100) + '\n';
+    }
+    input += "EOF";
+
+    auto sequential = tsplib::utils::AlignedVector<float> {};
+    const auto sequentialRest = tsplib::appendReals(input, sequential, 1);
+
+    auto parallel = tsplib::utils::AlignedVector<float> {};
+    const auto parallelRest = tsplib::appendReals(input, parallel, 4);
+
+    EXPECT_EQ(sequential.size(), 300000);
+    EXPECT_EQ(sequential, parallel);
+    EXPECT_EQ(sequentialRest.data(), parallelRest.data());
+}
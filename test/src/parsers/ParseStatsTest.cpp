@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include "ParseStats.h"
+#include "Reader.h"
+
+#include <filesystem>
+
+#ifdef TSPLIB_HAS_ZLIB
+#include <zlib.h>
+#endif
+
+namespace
+{
+
+constexpr auto explicitInstance = "NAME: stats\n"
+                                  "TYPE: ATSP\n"
+                                  "DIMENSION: 3\n"
+                                  "EDGE_WEIGHT_TYPE: EXPLICIT\n"
+                                  "EDGE_WEIGHT_FORMAT: FULL_MATRIX\n"
+                                  "EDGE_WEIGHT_SECTION\n"
+                                  "0 1 2\n"
+                                  "3 0 5\n"
+                                  "6 7 0\n"
+                                  "EOF\n";
+
+constexpr auto edgeDataInstance = "NAME: edges\n"
+                                  "TYPE: HCP\n"
+                                  "DIMENSION: 3\n"
+                                  "EDGE_WEIGHT_TYPE: EUC_2D\n"
+                                  "EDGE_DATA_FORMAT: EDGE_LIST\n"
+                                  "NODE_COORD_SECTION\n"
+                                  "1 0.0 0.0\n"
+                                  "2 3.0 4.0\n"
+                                  "3 6.0 8.0\n"
+                                  "EDGE_DATA_SECTION\n"
+                                  "1 2\n"
+                                  "2 3\n"
+                                  "-1\n"
+                                  "EOF\n";
+
+}
+
+#ifdef TSPLIB_PARSE_STATS
+
+TEST(ParseStatsTest, ExplicitInstance)
+{
+    auto stats = tsplib::ParseStats {};
+    const auto content = tsplib::getTspContent(explicitInstance, {.stats = &stats});
+
+    ASSERT_NO_THROW(content.value());
+    EXPECT_EQ(stats.bytes, std::string_view {explicitInstance}.size());
+    // 6 specification items counting EOF, and 9 weights
+    EXPECT_EQ(stats.tokens, 6 + 9);
+    EXPECT_GT(stats.allocations, 0);
+    EXPECT_GE(stats.peakAllocatedBytes, 9 * sizeof(tsplib::Graph::Weight));
+    EXPECT_EQ(stats.representation, tsplib::Graph::Representation::DENSE_MATRIX);
+
+    EXPECT_GT(stats.total.count(), 0);
+    EXPECT_GE(stats.total, stats.tokenizing + stats.filtering + stats.graphBuilding);
+    EXPECT_EQ(stats.distances.count(), 0);
+}
+
+TEST(ParseStatsTest, DistancesArePartOfGraphBuilding)
+{
+    auto stats = tsplib::ParseStats {};
+    const auto content = tsplib::getTspContent(edgeDataInstance, {.stats = &stats});
+
+    ASSERT_NO_THROW(content.value());
+    // 6 specification items counting EOF, 3 nodes of 3 numbers and 5 edge data numbers
+    EXPECT_EQ(stats.tokens, 6 + 9 + 5);
+    EXPECT_GT(stats.distances.count(), 0);
+    EXPECT_LE(stats.distances, stats.graphBuilding);
+}
+
+TEST(ParseStatsTest, LoadsAccumulate)
+{
+    auto stats = tsplib::ParseStats {};
+    ASSERT_TRUE(tsplib::getTspContent(explicitInstance, {.stats = &stats}).has_value());
+    ASSERT_TRUE(tsplib::getTspContent(explicitInstance, {.stats = &stats}).has_value());
+
+    EXPECT_EQ(stats.bytes, 2 * std::string_view {explicitInstance}.size());
+    EXPECT_EQ(stats.tokens, 2 * (6 + 9));
+}
+
+#ifdef TSPLIB_HAS_ZLIB
+
+TEST(ParseStatsTest, GzipFile)
+{
+    const auto path = std::filesystem::temp_directory_path() / "tsp_reader_stats.atsp.gz";
+    {
+        auto* const file = gzopen(path.c_str(), "wb");
+        ASSERT_NE(file, nullptr);
+        ASSERT_EQ(gzputs(file, explicitInstance), static_cast<int>(std::string_view {explicitInstance}.size()));
+        gzclose(file);
+    }
+
+    auto stats = tsplib::ParseStats {};
+    const auto content = tsplib::getTspContentFromFile(path, {.stats = &stats});
+    std::filesystem::remove(path);
+
+    ASSERT_NO_THROW(content.value());
+    EXPECT_EQ(stats.bytes, std::string_view {explicitInstance}.size());
+    EXPECT_EQ(stats.tokens, 6 + 9);
+    EXPECT_GT(stats.allocations, 0);
+    EXPECT_EQ(stats.representation, tsplib::Graph::Representation::DENSE_MATRIX);
+
+    EXPECT_GT(stats.total.count(), 0);
+    EXPECT_GE(stats.total, stats.tokenizing + stats.filtering + stats.graphBuilding);
+}
+
+#endif
+
+#else
+
+TEST(ParseStatsTest, CompiledOut)
+{
+    auto stats = tsplib::ParseStats {};
+    const auto content = tsplib::getTspContent(edgeDataInstance, {.stats = &stats});
+
+    ASSERT_NO_THROW(content.value());
+    EXPECT_FALSE(tsplib::PARSE_STATS_ENABLED);
+    EXPECT_EQ(stats.total.count(), 0);
+    EXPECT_EQ(stats.bytes, 0);
+    EXPECT_EQ(stats.tokens, 0);
+    EXPECT_EQ(stats.allocations, 0);
+    EXPECT_FALSE(stats.representation.has_value());
+}
+
+#endif
@@ -95,4 +95,85 @@ TEST(ParserTest, Real)
     ASSERT_THROW(fp::real<float>("ab1.1").value(), std::bad_optional_access);
     ASSERT_THROW(fp::real<float>("999999999999999999999999999999999999999999999999999999999999999999999999").value(),
                  std::bad_optional_access);
-}
\ No newline at end of file
+}
+
+TEST(ParserTest, Many)
+{
+    ASSERT_NO_THROW(fp::many(fp::digit)("123abc").value());
+    EXPECT_EQ(fp::many(fp::digit)("123abc")->first, "123");
+    EXPECT_EQ(fp::many(fp::digit)("123abc")->second, "abc");
+
+    ASSERT_NO_THROW(fp::many(fp::digit)("abc").value());
+    EXPECT_EQ(fp::many(fp::digit)("abc")->first, "");
+
+    const auto integers = fp::many(fp::tokenLeft(fp::integer<int>))(" 1 -2\n3 x");
+    ASSERT_NO_THROW(integers.value());
+    EXPECT_EQ(integers->first, (std::vector {1, -2, 3}));
+    EXPECT_EQ(integers->second, " x");
+
+    ASSERT_NO_THROW(fp::many(fp::many(fp::digit))("12").value());
+    EXPECT_EQ(fp::many(fp::many(fp::digit))("12")->first, std::vector<std::string_view> {"12"});
+}
+
+TEST(ParserTest, Some)
+{
+    ASSERT_NO_THROW(fp::some(fp::digit)("123abc").value());
+    EXPECT_EQ(fp::some(fp::digit)("123abc")->first, "123");
+
+    ASSERT_THROW(fp::some(fp::digit)("abc").value(), std::bad_optional_access);
+
+    const auto integers = fp::some(fp::tokenLeft(fp::integer<int>))("4 5 6");
+    ASSERT_NO_THROW(integers.value());
+    EXPECT_EQ(integers->first, (std::vector {4, 5, 6}));
+    EXPECT_EQ(integers->second, "");
+
+    ASSERT_THROW(fp::some(fp::tokenLeft(fp::integer<int>))(" a").value(), std::bad_optional_access);
+}
+
+TEST(ParserTest, SomeLargeInput)
+{
+    static constexpr auto count = size_t {1'000'000};
+
+    auto input = std::string {};
+    input.reserve(count * 4);
+    for (auto i = size_t {}; i < count; i++)
+    {
+        input += std::to_string(i % 1000) + ' ';
+    }
+
+    const auto integers = fp::some(fp::tokenLeft(fp::integer<int>))(input);
+    ASSERT_NO_THROW(integers.value());
+    ASSERT_EQ(integers->first.size(), count);
+    EXPECT_EQ(integers->first.back(), static_cast<int>((count - 1) % 1000));
+}
+
+
+TEST(ParserTest, Capture)
+{
+    const auto input = std::string_view {"-12.5e3 rest"};
+    const auto result = fp::capture(fp::sequence([](auto, auto) { return 0; }, fp::symbol('-'), fp::some(fp::digit)))(input);
+
+    ASSERT_NO_THROW(result.value());
+    EXPECT_EQ(result->first, "-12");
+    EXPECT_EQ(result->first.data(), input.data());
+    EXPECT_EQ(result->second, ".5e3 rest");
+
+    ASSERT_THROW(fp::capture(fp::digit)("x").value(), std::bad_optional_access);
+}
+
+TEST(ParserTest, ViewsIntoInput)
+{
+    const auto input = std::string_view {"NAME: x\r\nEOF"};
+
+    const auto keyword = fp::str("NAME")(input);
+    ASSERT_NO_THROW(keyword.value());
+    EXPECT_EQ(keyword->first.data(), input.data());
+
+    const auto line = fp::line(input);
+    ASSERT_NO_THROW(line.value());
+    EXPECT_EQ(line->first, "NAME: x");
+    EXPECT_EQ(line->first.data(), input.data());
+    EXPECT_EQ(line->second, "EOF");
+
+    EXPECT_EQ(fp::line(line->second)->first, "EOF");
+}
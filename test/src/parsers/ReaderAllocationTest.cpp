@@ -0,0 +1,261 @@
+#include <gtest/gtest.h>
+
+#include "ParseStats.h"
+#include "Reader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+/**
+ * Replaces the global allocation functions of the whole test binary, so only large blocks
+ * allocated while a test explicitly counts are recorded. With TSPLIB_PARSE_STATS the library
+ * replaces them itself and the statistics are checked instead.
+ */
+namespace
+{
+
+#ifndef TSPLIB_PARSE_STATS
+
+std::atomic<bool> isCounting {false};
+std::atomic<size_t> countedMinimalSize {};
+std::atomic<size_t> largeAllocations {};
+
+auto countAllocation(size_t size) -> void
+{
+    if (isCounting && size >= countedMinimalSize)
+    {
+        largeAllocations++;
+    }
+}
+
+auto countedAllocate(size_t size) -> void*
+{
+    countAllocation(size);
+
+    if (auto* memory = std::malloc(size == 0 ? 1 : size))
+    {
+        return memory;
+    }
+
+    throw std::bad_alloc {};
+}
+
+/**
+ * The weights of a graph are allocated cache line aligned
+ */
+auto countedAllocate(size_t size, std::align_val_t alignment) -> void*
+{
+    countAllocation(size);
+
+    const auto bytes = static_cast<size_t>(alignment);
+    if (auto* memory = std::aligned_alloc(bytes, std::max((size + bytes - 1) / bytes * bytes, bytes)))
+    {
+        return memory;
+    }
+
+    throw std::bad_alloc {};
+}
+
+#endif
+
+auto makeFullMatrixInstance(size_t dimension) -> std::string
+{
+    auto instance = "NAME: counted\nTYPE: ATSP\nDIMENSION: " + std::to_string(dimension) + "\n"
+                    "EDGE_WEIGHT_TYPE: EXPLICIT\nEDGE_WEIGHT_FORMAT: FULL_MATRIX\nEDGE_WEIGHT_SECTION\n";
+
+    for (auto i = size_t {}; i < dimension; i++)
+    {
+        for (auto j = size_t {}; j < dimension; j++)
+        {
+            instance += std::to_string((i * 31 + j * 17) % 1000) + ' ';
+        }
+        instance += '\n';
+    }
+
+    return instance + "EOF\n";
+}
+
+/**
+ * Triangle without the diagonal of a symmetric instance, in one of the *_ROW formats
+ */
+auto makeTriangleInstance(size_t dimension, std::string_view format) -> std::string
+{
+    auto instance = "NAME: counted\nTYPE: TSP\nDIMENSION: " + std::to_string(dimension) + "\n"
+                    "EDGE_WEIGHT_TYPE: EXPLICIT\nEDGE_WEIGHT_FORMAT: " + std::string {format} + "\nEDGE_WEIGHT_SECTION\n";
+
+    for (auto i = size_t {}; i < dimension; i++)
+    {
+        const auto [first, last] = format == "LOWER_ROW" ? std::pair {size_t {}, i} : std::pair {i + 1, dimension};
+        for (auto j = first; j < last; j++)
+        {
+            instance += std::to_string((i + j) % 1000) + ' ';
+        }
+        instance += '\n';
+    }
+
+    return instance + "EOF\n";
+}
+
+}
+
+#ifndef TSPLIB_PARSE_STATS
+
+auto operator new(size_t size) -> void*
+{
+    return countedAllocate(size);
+}
+
+auto operator new[](size_t size) -> void*
+{
+    return countedAllocate(size);
+}
+
+auto operator new(size_t size, std::align_val_t alignment) -> void*
+{
+    return countedAllocate(size, alignment);
+}
+
+auto operator new[](size_t size, std::align_val_t alignment) -> void*
+{
+    return countedAllocate(size, alignment);
+}
+
+auto operator delete(void* memory) noexcept -> void
+{
+    std::free(memory);
+}
+
+auto operator delete[](void* memory) noexcept -> void
+{
+    std::free(memory);
+}
+
+auto operator delete(void* memory, size_t) noexcept -> void
+{
+    std::free(memory);
+}
+
+auto operator delete[](void* memory, size_t) noexcept -> void
+{
+    std::free(memory);
+}
+
+auto operator delete(void* memory, std::align_val_t) noexcept -> void
+{
+    std::free(memory);
+}
+
+auto operator delete[](void* memory, std::align_val_t) noexcept -> void
+{
+    std::free(memory);
+}
+
+auto operator delete(void* memory, size_t, std::align_val_t) noexcept -> void
+{
+    std::free(memory);
+}
+
+auto operator delete[](void* memory, size_t, std::align_val_t) noexcept -> void
+{
+    std::free(memory);
+}
+
+#endif
+
+TEST(ReaderAllocationTest, MatrixIsAllocatedOnce)
+{
+    static constexpr auto dimension = size_t {256};
+    static constexpr auto matrixSize = dimension * dimension * sizeof(tsplib::Graph::Weight);
+
+    const auto instance = makeFullMatrixInstance(dimension);
+
+#ifdef TSPLIB_PARSE_STATS
+    auto stats = tsplib::ParseStats {};
+    const auto content = tsplib::getTspContent(instance, {.stats = &stats});
+
+    ASSERT_NO_THROW(content.value());
+    EXPECT_EQ(content->graph.getOrder(), dimension);
+    // Any copy of the section or the matrix would hold a second matrix at the same time
+    EXPECT_GE(stats.peakAllocatedBytes, matrixSize);
+    EXPECT_LT(stats.peakAllocatedBytes, matrixSize * 3 / 2);
+#else
+    // Any copy of the section or the matrix, and any reallocation while it grows, would be at least this large
+    countedMinimalSize = matrixSize / 2;
+    largeAllocations = 0;
+    isCounting = true;
+    const auto content = tsplib::getTspContent(instance);
+    isCounting = false;
+
+    ASSERT_NO_THROW(content.value());
+    EXPECT_EQ(content->graph.getOrder(), dimension);
+    EXPECT_EQ(content->graph.getWeight({1, 2}).value(), (31 + 2 * 17) % 1000);
+    EXPECT_EQ(largeAllocations, 1);
+#endif
+}
+
+TEST(ReaderAllocationTest, TriangleIsAllocatedAtItsSize)
+{
+    static constexpr auto dimension = size_t {512};
+    static constexpr auto triangleSize = dimension * (dimension - 1) / 2 * sizeof(tsplib::Graph::Weight);
+
+    for (const auto format : {"LOWER_ROW", "UPPER_ROW"})
+    {
+        const auto instance = makeTriangleInstance(dimension, format);
+
+#ifdef TSPLIB_PARSE_STATS
+        auto stats = tsplib::ParseStats {};
+        const auto content = tsplib::getTspContent(instance, {.stats = &stats});
+
+        ASSERT_NO_THROW(content.value());
+        EXPECT_EQ(content->graph.getRepresentation(), tsplib::Graph::Representation::PACKED_SYMMETRIC);
+        // The upper triangle is transposed into a second one, the full matrix is never reserved
+        EXPECT_LT(stats.peakAllocatedBytes, triangleSize * 5 / 2) << format;
+#else
+        // A reservation of the padded matrix would be about twice the triangle
+        countedMinimalSize = triangleSize * 3 / 2;
+        largeAllocations = 0;
+        isCounting = true;
+        const auto content = tsplib::getTspContent(instance);
+        isCounting = false;
+
+        ASSERT_NO_THROW(content.value());
+        EXPECT_EQ(content->graph.getRepresentation(), tsplib::Graph::Representation::PACKED_SYMMETRIC);
+        EXPECT_EQ(content->graph.getWeight({2, 5}).value(), 7);
+        EXPECT_EQ(content->graph.getWeight({5, 2}).value(), 7);
+        EXPECT_EQ(largeAllocations, 0) << format;
+#endif
+    }
+}
+
+TEST(ReaderAllocationTest, NarrowMatrixIsAllocatedOnce)
+{
+    static constexpr auto dimension = size_t {256};
+    static constexpr auto matrixSize = dimension * dimension * sizeof(int16_t);
+
+    const auto instance = makeFullMatrixInstance(dimension);
+
+#ifdef TSPLIB_PARSE_STATS
+    auto stats = tsplib::ParseStats {};
+    const auto content = tsplib::getTspContentAs<int16_t>(instance, {.stats = &stats});
+
+    ASSERT_NO_THROW(content.value());
+    EXPECT_EQ(content->graph.getOrder(), dimension);
+    // The section is never scanned into 32 bit weights, which would take twice the narrow matrix
+    EXPECT_GE(stats.peakAllocatedBytes, matrixSize);
+    EXPECT_LT(stats.peakAllocatedBytes, matrixSize * 3 / 2);
+#else
+    countedMinimalSize = matrixSize / 2;
+    largeAllocations = 0;
+    isCounting = true;
+    const auto content = tsplib::getTspContentAs<int16_t>(instance);
+    isCounting = false;
+
+    ASSERT_NO_THROW(content.value());
+    EXPECT_EQ(content->graph.getOrder(), dimension);
+    EXPECT_EQ(content->graph.getWeight({1, 2}).value(), (31 + 2 * 17) % 1000);
+    EXPECT_EQ(largeAllocations, 1);
+#endif
+}
@@ -2,53 +2,71 @@
 
 #include "Reader.h"
 
-TEST(ReaderTest, getTspContentTest)
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifdef TSPLIB_HAS_ZLIB
+#include <zlib.h>
+#endif
+
+#if __has_include(<stdlib.h>) && __has_include(<unistd.h>)
+#define TSPLIB_HAS_SETENV
+#include <stdlib.h>
+#endif
+
+namespace
 {
-    constexpr static auto instance = "NAME:  br17\n"
-                                     "TYPE: ATSP\n"
-                                     "COMMENT: 17 city problem (Repetto)\n"
-                                     "DIMENSION:  17\n"
-                                     "EDGE_WEIGHT_TYPE: EXPLICIT\n"
-                                     "EDGE_WEIGHT_FORMAT: FULL_MATRIX\n"
-                                     "UNKNOWN_TAG1: aaa\n"
-                                     "UNKNOWN_TAG2\n"
-                                     "EDGE_WEIGHT_SECTION:\n"
-                                     " 9999    3    5   48   48    8    8    5    5    3    3    0    3    5    8    8\n"
-                                     "    5\n"
-                                     "    3 9999    3   48   48    8    8    5    5    0    0    3    0    3    8    8\n"
-                                     "    5\n"
-                                     "    5    3 9999   72   72   48   48   24   24    3    3    5    3    0   48   48\n"
-                                     "   24\n"
-                                     "   48   48   74 9999    0    6    6   12   12   48   48   48   48   74    6    6\n"
-                                     "   12\n"
-                                     "   48   48   74    0 9999    6    6   12   12   48   48   48   48   74    6    6\n"
-                                     "   12\n"
-                                     "    8    8   50    6    6 9999    0    8    8    8    8    8    8   50    0    0\n"
-                                     "    8\n"
-                                     "    8    8   50    6    6    0 9999    8    8    8    8    8    8   50    0    0\n"
-                                     "    8\n"
-                                     "    5    5   26   12   12    8    8 9999    0    5    5    5    5   26    8    8\n"
-                                     "    0\n"
-                                     "    5    5   26   12   12    8    8    0 9999    5    5    5    5   26    8    8\n"
-                                     "    0\n"
-                                     "    3    0    3   48   48    8    8    5    5 9999    0    3    0    3    8    8\n"
-                                     "    5\n"
-                                     "    3    0    3   48   48    8    8    5    5    0 9999    3    0    3    8    8\n"
-                                     "    5\n"
-                                     "    0    3    5   48   48    8    8    5    5    3    3 9999    3    5    8    8\n"
-                                     "    5\n"
-                                     "    3    0    3   48   48    8    8    5    5    0    0    3 9999    3    8    8\n"
-                                     "    5\n"
-                                     "    5    3    0   72   72   48   48   24   24    3    3    5    3 9999   48   48\n"
-                                     "   24\n"
-                                     "    8    8   50    6    6    0    0    8    8    8    8    8    8   50 9999    0\n"
-                                     "    8\n"
-                                     "    8    8   50    6    6    0    0    8    8    8    8    8    8   50    0 9999\n"
-                                     "    8\n"
-                                     "    5    5   26   12   12    8    8    0    0    5    5    5    5   26    8    8\n"
-                                     " 9999\n"
-                                     "EOF";
 
+constexpr auto instance = "NAME:  br17\n"
+                             "TYPE: ATSP\n"
+                             "COMMENT: 17 city problem (Repetto)\n"
+                             "DIMENSION:  17\n"
+                             "EDGE_WEIGHT_TYPE: EXPLICIT\n"
+                             "EDGE_WEIGHT_FORMAT: FULL_MATRIX\n"
+                             "UNKNOWN_TAG1: aaa\n"
+                             "UNKNOWN_TAG2\n"
+                             "EDGE_WEIGHT_SECTION:\n"
+                             " 9999    3    5   48   48    8    8    5    5    3    3    0    3    5    8    8\n"
+                             "    5\n"
+                             "    3 9999    3   48   48    8    8    5    5    0    0    3    0    3    8    8\n"
+                             "    5\n"
+                             "    5    3 9999   72   72   48   48   24   24    3    3    5    3    0   48   48\n"
+                             "   24\n"
+                             "   48   48   74 9999    0    6    6   12   12   48   48   48   48   74    6    6\n"
+                             "   12\n"
+                             "   48   48   74    0 9999    6    6   12   12   48   48   48   48   74    6    6\n"
+                             "   12\n"
+                             "    8    8   50    6    6 9999    0    8    8    8    8    8    8   50    0    0\n"
+                             "    8\n"
+                             "    8    8   50    6    6    0 9999    8    8    8    8    8    8   50    0    0\n"
+                             "    8\n"
+                             "    5    5   26   12   12    8    8 9999    0    5    5    5    5   26    8    8\n"
+                             "    0\n"
+                             "    5    5   26   12   12    8    8    0 9999    5    5    5    5   26    8    8\n"
+                             "    0\n"
+                             "    3    0    3   48   48    8    8    5    5 9999    0    3    0    3    8    8\n"
+                             "    5\n"
+                             "    3    0    3   48   48    8    8    5    5    0 9999    3    0    3    8    8\n"
+                             "    5\n"
+                             "    0    3    5   48   48    8    8    5    5    3    3 9999    3    5    8    8\n"
+                             "    5\n"
+                             "    3    0    3   48   48    8    8    5    5    0    0    3 9999    3    8    8\n"
+                             "    5\n"
+                             "    5    3    0   72   72   48   48   24   24    3    3    5    3 9999   48   48\n"
+                             "   24\n"
+                             "    8    8   50    6    6    0    0    8    8    8    8    8    8   50 9999    0\n"
+                             "    8\n"
+                             "    8    8   50    6    6    0    0    8    8    8    8    8    8   50    0 9999\n"
+                             "    8\n"
+                             "    5    5   26   12   12    8    8    0    0    5    5    5    5   26    8    8\n"
+                             " 9999\n"
+                             "EOF";
+
+}
+
+TEST(ReaderTest, getTspContentTest)
+{
     const auto content = tsplib::getTspContent(instance);
 
     ASSERT_NO_THROW(content.value());
@@ -60,4 +78,626 @@ TEST(ReaderTest, getTspContentTest)
     EXPECT_EQ(graph.getWeight({0, 3}).value(), 48);
     EXPECT_EQ(graph.getWeightUnchecked({2, 3}), 72);
     EXPECT_EQ(graph.getWeight({13, 12}).value(), 3);
-}
\ No newline at end of file
+}
+
+TEST(ReaderTest, getTspContentFromFileTest)
+{
+    const auto path = std::filesystem::temp_directory_path() / "tsp_reader_br17.atsp";
+    {
+        auto file = std::ofstream {path, std::ios::binary};
+        file << instance;
+    }
+
+    const auto content = tsplib::getTspContentFromFile(path);
+    std::filesystem::remove(path);
+
+    ASSERT_NO_THROW(content.value());
+    EXPECT_EQ(content->metaData.name.value(), "br17");
+    EXPECT_EQ(content->graph.getOrder(), 17);
+    EXPECT_EQ(content->graph.getWeight({0, 3}).value(), 48);
+
+    EXPECT_FALSE(tsplib::getTspContentFromFile(path).has_value());
+}
+
+TEST(ReaderTest, CoordinatesTest)
+{
+    const auto content = tsplib::getTspContent("NAME : edges\n"
+                                               "TYPE : HCP\n"
+                                               "DIMENSION : 3\n"
+                                               "EDGE_WEIGHT_TYPE : EUC_2D\n"
+                                               "EDGE_DATA_FORMAT : EDGE_LIST\n"
+                                               "NODE_COORD_SECTION\n"
+                                               "1 36266.6667 62550.0000\n"
+                                               "2 34600.0000 58633.3333\n"
+                                               "3 51650.0000 72300.0000\n"
+                                               "EDGE_DATA_SECTION\n"
+                                               "1 2\n"
+                                               "2 3\n"
+                                               "-1\n"
+                                               "EOF\n");
+
+    ASSERT_NO_THROW(content.value());
+
+    const auto& points = std::get<std::vector<tsplib::Point2d>>(content->coordinates.value());
+    ASSERT_EQ(points.size(), 3);
+    EXPECT_EQ(points[1].id, 2);
+    EXPECT_EQ(points[1].x, 34600.0);
+    EXPECT_EQ(points[2].y, 72300.0);
+
+    EXPECT_FALSE(tsplib::getTspContent(instance)->coordinates.has_value());
+}
+
+TEST(ReaderTest, EdgeDataGraphIsSparse)
+{
+    const auto content = tsplib::getTspContent("NAME : edges\n"
+                                               "TYPE : HCP\n"
+                                               "DIMENSION : 4\n"
+                                               "EDGE_WEIGHT_TYPE : EUC_2D\n"
+                                               "EDGE_DATA_FORMAT : ADJ_LIST\n"
+                                               "NODE_COORD_SECTION\n"
+                                               "1 0.0 0.0\n"
+                                               "2 3.0 4.0\n"
+                                               "3 6.0 8.0\n"
+                                               "4 0.0 8.0\n"
+                                               "EDGE_DATA_SECTION\n"
+                                               "1 2 3 -1\n"
+                                               "2 4 -1\n"
+                                               "-1\n"
+                                               "EOF\n");
+
+    ASSERT_NO_THROW(content.value());
+    EXPECT_EQ(content->graph.getRepresentation(), tsplib::Graph::Representation::SPARSE_ROWS);
+    EXPECT_EQ(content->graph.getOrder(), 4);
+    EXPECT_EQ(content->graph.getEdges(), (std::vector<tsplib::Graph::EdgeData> {{{0, 1}, 5}, {{0, 2}, 10}, {{1, 3}, 5}}));
+
+    const auto edgeList = tsplib::getTspContent("NAME : edges\n"
+                                                "TYPE : HCP\n"
+                                                "DIMENSION : 3\n"
+                                                "EDGE_WEIGHT_TYPE : EUC_2D\n"
+                                                "EDGE_DATA_FORMAT : EDGE_LIST\n"
+                                                "NODE_COORD_SECTION\n"
+                                                "1 0.0 0.0\n"
+                                                "2 3.0 4.0\n"
+                                                "3 6.0 8.0\n"
+                                                "EDGE_DATA_SECTION\n"
+                                                "1 2\n"
+                                                "2 3\n"
+                                                "-1\n"
+                                                "EOF\n");
+
+    ASSERT_NO_THROW(edgeList.value());
+    EXPECT_EQ(edgeList->graph.getRepresentation(), tsplib::Graph::Representation::SPARSE_ROWS);
+    EXPECT_EQ(edgeList->graph.getOrder(), 3);
+    EXPECT_EQ(edgeList->graph.getEdges(), (std::vector<tsplib::Graph::EdgeData> {{{0, 1}, 5}, {{1, 2}, 5}}));
+
+    const auto outOfRange = tsplib::getTspContent("NAME : edges\n"
+                                                  "TYPE : HCP\n"
+                                                  "DIMENSION : 2\n"
+                                                  "EDGE_WEIGHT_TYPE : EUC_2D\n"
+                                                  "EDGE_DATA_FORMAT : ADJ_LIST\n"
+                                                  "NODE_COORD_SECTION\n"
+                                                  "1 0.0 0.0\n"
+                                                  "2 3.0 4.0\n"
+                                                  "EDGE_DATA_SECTION\n"
+                                                  "1 2 3 -1\n"
+                                                  "-1\n"
+                                                  "EOF\n");
+
+    EXPECT_FALSE(outOfRange.has_value());
+}
+
+TEST(ReaderTest, LargeSectionsOnThreads)
+{
+    // Both sections are large enough to be split among the threads
+    auto nodes = std::string {"NAME: nodes\n"
+                              "TYPE: HCP\n"
+                              "DIMENSION: 150000\n"
+                              "EDGE_WEIGHT_TYPE: EUC_2D\n"
+                              "EDGE_DATA_FORMAT: EDGE_LIST\n"
+                              "NODE_COORD_SECTION\n"};
+    for (auto id = 1; id <= 150000; id++)
+    {
+        nodes += std::to_string(id) + " " + std::to_string(id % 1000) + ".5 " + std::to_string(id / 1000) + "\n";
+    }
+    nodes += "EDGE_DATA_SECTION\n1 2\n2 150000\n149999 1\n-1\nEOF\n";
+
+    auto matrix = std::string {"NAME: matrix\n"
+                               "TYPE: ATSP\n"
+                               "DIMENSION: 700\n"
+                               "EDGE_WEIGHT_TYPE: EXPLICIT\n"
+                               "EDGE_WEIGHT_FORMAT: FULL_MATRIX\n"
+                               "EDGE_WEIGHT_SECTION\n"};
+    for (auto i = 0; i < 700; i++)
+    {
+        for (auto j = 0; j < 700; j++)
+        {
+            matrix += std::to_string((i * 7919 + j * 104729) % 100000) + (j + 1 < 700 ? " " : "\n");
+        }
+    }
+    matrix += "EOF\n";
+
+    for (const auto& input : {nodes, matrix})
+    {
+        const auto expected = tsplib::getTspContent(input);
+        ASSERT_TRUE(expected.has_value());
+
+        for (const auto threads : {2u, 8u})
+        {
+            const auto actual = tsplib::getTspContent(input, {.threads = threads});
+            ASSERT_TRUE(actual.has_value());
+            EXPECT_EQ(actual->graph.getOrder(), expected->graph.getOrder());
+            EXPECT_EQ(actual->graph.getEdges(), expected->graph.getEdges());
+            EXPECT_EQ(actual->coordinates.has_value(), expected->coordinates.has_value());
+        }
+    }
+
+    const auto content = tsplib::getTspContent(nodes, {.threads = 8});
+    ASSERT_TRUE(content.has_value());
+    EXPECT_EQ(content->graph.getWeight({1, 149999}).value(), 150);
+    EXPECT_EQ(std::get<std::vector<tsplib::Point2d>>(content->coordinates.value()).size(), 150000);
+}
+
+TEST(ReaderTest, getTspContentsTest)
+{
+    const auto directory = std::filesystem::temp_directory_path();
+    const auto small = "NAME: small\n"
+                       "TYPE: TSP\n"
+                       "DIMENSION: 3\n"
+                       "EDGE_WEIGHT_TYPE: EXPLICIT\n"
+                       "EDGE_WEIGHT_FORMAT: UPPER_ROW\n"
+                       "EDGE_WEIGHT_SECTION\n"
+                       "1 2\n"
+                       "3\n"
+                       "EOF\n";
+    const auto paths = std::vector<std::filesystem::path> {
+        directory / "tsp_reader_batch_small.tsp",
+        directory / "tsp_reader_batch_missing.tsp",
+        directory / "tsp_reader_batch_br17.atsp",
+        directory / "tsp_reader_batch_broken.tsp",
+    };
+
+    std::ofstream {paths[0], std::ios::binary} << small;
+    std::ofstream {paths[2], std::ios::binary} << instance;
+    std::ofstream {paths[3], std::ios::binary} << "NAME: broken\nEDGE_WEIGHT_SECTION\n1 2 3\n";
+
+    for (const auto threads : {1u, 2u, 8u})
+    {
+        const auto contents = tsplib::getTspContents(paths, threads);
+
+        ASSERT_EQ(contents.size(), paths.size());
+        ASSERT_TRUE(contents[0].has_value());
+        EXPECT_EQ(contents[0]->metaData.name.value(), "small");
+        EXPECT_EQ(contents[0]->graph.getWeight({2, 1}).value(), 3);
+        EXPECT_FALSE(contents[1].has_value());
+        ASSERT_TRUE(contents[2].has_value());
+        EXPECT_EQ(contents[2]->metaData.name.value(), "br17");
+        EXPECT_EQ(contents[2]->graph.getOrder(), 17);
+        EXPECT_FALSE(contents[3].has_value());
+    }
+
+    EXPECT_TRUE(tsplib::getTspContents({}, 4).empty());
+
+    for (const auto& path : paths)
+    {
+        std::filesystem::remove(path);
+    }
+}
+
+TEST(ReaderTest, getTspContentCachedTest)
+{
+    const auto path = std::filesystem::temp_directory_path() / "tsp_reader_cached.tsp";
+    auto cachePath = path;
+    cachePath += ".tspcache";
+    std::filesystem::remove(cachePath);
+
+    std::ofstream {path, std::ios::binary} << "NAME: cached\n"
+                                              "TYPE: TSP\n"
+                                              "DIMENSION: 3\n"
+                                              "EDGE_WEIGHT_TYPE: EXPLICIT\n"
+                                              "EDGE_WEIGHT_FORMAT: FULL_MATRIX\n"
+                                              "EDGE_WEIGHT_SECTION\n"
+                                              "0 1 2\n"
+                                              "3 0 5\n"
+                                              "6 7 0\n"
+                                              "EOF\n";
+
+    const auto first = tsplib::getTspContentCached(path);
+
+    ASSERT_NO_THROW(first.value());
+    ASSERT_TRUE(std::filesystem::exists(cachePath));
+    EXPECT_EQ(first->getMetaData().name.value(), "cached");
+    EXPECT_EQ(first->getOrder(), 3);
+    EXPECT_EQ(first->getSize(), 6);
+    EXPECT_EQ(first->getWeights()[1 * 3 + 2], 5);
+    EXPECT_EQ(first->getWeights()[1 * 3 + 1], tsplib::Graph::INFINITY_WEIGHT);
+    EXPECT_FALSE(first->getCoordinates().has_value());
+
+    const auto cacheWriteTime = std::filesystem::last_write_time(cachePath);
+    const auto second = tsplib::getTspContentCached(path);
+
+    ASSERT_NO_THROW(second.value());
+    EXPECT_EQ(std::filesystem::last_write_time(cachePath), cacheWriteTime);
+    EXPECT_EQ(second->getSourceHash(), first->getSourceHash());
+
+    const auto content = second->toContent();
+    EXPECT_EQ(content.graph.getOrder(), 3);
+    EXPECT_EQ(content.graph.getSize(), 6);
+    EXPECT_EQ(content.graph.getWeight({2, 1}).value(), 7);
+
+    // A changed instance gets a new cache
+    std::ofstream {path, std::ios::binary} << "NAME: changed\n"
+                                              "TYPE: TSP\n"
+                                              "DIMENSION: 2\n"
+                                              "EDGE_WEIGHT_TYPE: EXPLICIT\n"
+                                              "EDGE_WEIGHT_FORMAT: FULL_MATRIX\n"
+                                              "EDGE_WEIGHT_SECTION\n"
+                                              "0 4\n"
+                                              "4 0\n"
+                                              "EOF\n";
+
+    const auto changed = tsplib::getTspContentCached(path);
+
+    ASSERT_NO_THROW(changed.value());
+    EXPECT_NE(changed->getSourceHash(), first->getSourceHash());
+    EXPECT_EQ(changed->getMetaData().name.value(), "changed");
+    EXPECT_EQ(changed->getOrder(), 2);
+
+    // The first load still reads its own mapping
+    EXPECT_EQ(first->getWeights()[1 * 3 + 2], 5);
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(cachePath);
+    EXPECT_FALSE(tsplib::getTspContentCached(path).has_value());
+}
+
+TEST(ReaderTest, CachedContentKeepsRepresentation)
+{
+    const auto path = std::filesystem::temp_directory_path() / "tsp_reader_representation.tspcache";
+    const auto graphs = std::vector<tsplib::Graph> {
+        tsplib::Graph::fromEdges({{{0, 3}, 5}, {{3, 0}, 6}, {{2, 1}, 7}}, 4),
+        tsplib::Graph::fromSymmetricWeights({1, 2, tsplib::Graph::INFINITY_WEIGHT, 4, 5, 6}, 4).value(),
+    };
+
+    for (const auto& graph : graphs)
+    {
+        ASSERT_TRUE(tsplib::writeTspCache({.metaData = {}, .graph = graph, .coordinates = {}}, 3, path));
+
+        const auto cached = tsplib::CachedContent::open(path);
+        ASSERT_TRUE(cached.has_value());
+        EXPECT_EQ(cached->getRepresentation(), graph.getRepresentation());
+        EXPECT_EQ(cached->getSize(), graph.getSize());
+
+        const auto content = cached->toContent();
+        EXPECT_EQ(content.graph.getRepresentation(), graph.getRepresentation());
+        EXPECT_EQ(content.graph.getEdges(), graph.getEdges());
+    }
+
+    EXPECT_EQ(tsplib::CachedContent::open(path)->getWeights().size(), 6);
+    EXPECT_TRUE(tsplib::CachedContent::open(path)->getRowOffsets().empty());
+
+    std::filesystem::remove(path);
+}
+
+#ifdef TSPLIB_HAS_SETENV
+
+TEST(ReaderTest, getTspContentCachedFallsBackToUserCache)
+{
+    using std::filesystem::perms;
+
+    const auto directory = std::filesystem::temp_directory_path() / "tsp_reader_user_cache";
+    const auto path = directory / "instance.tsp";
+    const auto userCache = directory / "cache" / "tsplib";
+    std::filesystem::remove_all(directory);
+
+    // A directory in the way of the cache next to the instance
+    std::filesystem::create_directories(directory / "instance.tsp.tspcache");
+    std::ofstream {path, std::ios::binary} << "NAME: user\n"
+                                              "TYPE: TSP\n"
+                                              "DIMENSION: 2\n"
+                                              "EDGE_WEIGHT_TYPE: EXPLICIT\n"
+                                              "EDGE_WEIGHT_FORMAT: FULL_MATRIX\n"
+                                              "EDGE_WEIGHT_SECTION\n"
+                                              "0 4\n"
+                                              "4 0\n"
+                                              "EOF\n";
+
+    const auto* const previous = std::getenv("XDG_CACHE_HOME");
+    const auto previousValue = previous != nullptr ? std::optional<std::string> {previous} : std::nullopt;
+    ASSERT_EQ(::setenv("XDG_CACHE_HOME", (directory / "cache").c_str(), 1), 0);
+
+    const auto cached = tsplib::getTspContentCached(path);
+
+    ASSERT_TRUE(cached.has_value());
+    EXPECT_EQ(cached->getMetaData().name.value(), "user");
+    EXPECT_EQ(std::filesystem::status(userCache).permissions() & (perms::group_all | perms::others_all), perms::none);
+    EXPECT_EQ(std::distance(std::filesystem::directory_iterator {userCache}, {}), 1);
+
+    // A cache directory others can write to is neither read nor written
+    std::filesystem::permissions(userCache, perms::group_write | perms::others_write, std::filesystem::perm_options::add);
+    EXPECT_FALSE(tsplib::getTspContentCached(path).has_value());
+
+    if (previousValue)
+    {
+        ::setenv("XDG_CACHE_HOME", previousValue->c_str(), 1);
+    }
+    else
+    {
+        ::unsetenv("XDG_CACHE_HOME");
+    }
+    std::filesystem::remove_all(directory);
+}
+
+#endif
+
+#ifdef TSPLIB_HAS_ZLIB
+
+TEST(ReaderTest, getTspContentFromGzipFileTest)
+{
+    const auto path = std::filesystem::temp_directory_path() / "tsp_reader_br17.atsp.gz";
+    {
+        auto* const file = gzopen(path.c_str(), "wb");
+        ASSERT_NE(file, nullptr);
+        ASSERT_EQ(gzputs(file, instance), static_cast<int>(std::string_view {instance}.size()));
+        gzclose(file);
+    }
+
+    const auto content = tsplib::getTspContentFromFile(path);
+    std::filesystem::remove(path);
+
+    ASSERT_NO_THROW(content.value());
+    EXPECT_EQ(content->metaData.name.value(), "br17");
+    EXPECT_EQ(content->graph.getOrder(), 17);
+    EXPECT_EQ(content->graph.getWeight({13, 12}).value(), 3);
+}
+
+TEST(ReaderTest, getTspContentFromGzipFileOnThreads)
+{
+    // Decompressed windows of a few megabytes are split among the threads
+    auto matrix = std::string {"NAME: matrix\n"
+                               "TYPE: ATSP\n"
+                               "DIMENSION: 700\n"
+                               "EDGE_WEIGHT_TYPE: EXPLICIT\n"
+                               "EDGE_WEIGHT_FORMAT: FULL_MATRIX\n"
+                               "EDGE_WEIGHT_SECTION\n"};
+    for (auto i = 0; i < 700; i++)
+    {
+        for (auto j = 0; j < 700; j++)
+        {
+            matrix += std::to_string((i * 7919 + j * 104729) % 100000) + (j + 1 < 700 ? " " : "\n");
+        }
+    }
+    matrix += "EOF\n";
+
+    const auto path = std::filesystem::temp_directory_path() / "tsp_reader_matrix.atsp.gz";
+    {
+        auto* const file = gzopen(path.c_str(), "wb");
+        ASSERT_NE(file, nullptr);
+        ASSERT_EQ(gzwrite(file, matrix.data(), static_cast<unsigned>(matrix.size())), static_cast<int>(matrix.size()));
+        gzclose(file);
+    }
+
+    const auto expected = tsplib::getTspContent(matrix);
+    ASSERT_TRUE(expected.has_value());
+
+    for (const auto threads : {1u, 2u, 8u})
+    {
+        const auto actual = tsplib::getTspContentFromFile(path, {.threads = threads});
+        ASSERT_TRUE(actual.has_value());
+        EXPECT_EQ(actual->graph.getOrder(), 700);
+        EXPECT_EQ(actual->graph.getEdges(), expected->graph.getEdges());
+    }
+
+    std::filesystem::remove(path);
+}
+
+#endif
+
+TEST(ReaderTest, getTspHeaderTest)
+{
+    const auto header = tsplib::getTspHeader(instance);
+
+    ASSERT_NO_THROW(header.value());
+    EXPECT_EQ(header->metaData.name.value(), "br17");
+    EXPECT_EQ(header->metaData.type.value(), tsplib::Type::ATSP);
+    EXPECT_EQ(header->metaData.dimension.value(), 17);
+    EXPECT_EQ(header->edgeWeightType.value(), "EXPLICIT");
+
+    ASSERT_EQ(header->sections.size(), 1);
+    EXPECT_EQ(header->sections.front().tag, "EDGE_WEIGHT_SECTION");
+    EXPECT_EQ(std::string_view {instance}.substr(header->sections.front().offset, 19), "EDGE_WEIGHT_SECTION");
+
+    EXPECT_FALSE(tsplib::getTspHeader("NAME: br17\nDIMENSION: seventeen\nEOF").has_value());
+
+    // The reader cannot load ATT distances, but the header still tells what the instance is
+    const auto att = tsplib::getTspHeader("NAME: att48\n"
+                                          "TYPE: TSP\n"
+                                          "DIMENSION: 48\n"
+                                          "EDGE_WEIGHT_TYPE: ATT\n"
+                                          "NODE_COORD_SECTION\n"
+                                          "1 6734 1453\n"
+                                          "2 2233 10\n"
+                                          "EOF\n");
+    ASSERT_TRUE(att.has_value());
+    EXPECT_EQ(att->metaData.name.value(), "att48");
+    EXPECT_EQ(att->metaData.dimension.value(), 48);
+    EXPECT_EQ(att->edgeWeightType.value(), "ATT");
+    ASSERT_EQ(att->sections.size(), 1);
+    EXPECT_EQ(att->sections.front().tag, "NODE_COORD_SECTION");
+}
+
+TEST(ReaderTest, StreamReaderTest)
+{
+    const auto input = std::string_view {instance};
+    auto reader = tsplib::StreamReader {256};
+
+    for (auto position = size_t {}; position < input.size(); position += 100)
+    {
+        ASSERT_TRUE(reader.feed(input.substr(position, 100)));
+    }
+
+    const auto content = reader.finish();
+
+    ASSERT_NO_THROW(content.value());
+    EXPECT_EQ(content->metaData.name.value(), "br17");
+    EXPECT_EQ(content->graph.getOrder(), 17);
+    EXPECT_EQ(content->graph.getWeight({13, 12}).value(), 3);
+}
+
+TEST(ReaderTest, NarrowestWeightType)
+{
+    auto content = tsplib::narrowContent(tsplib::getTspContent(instance).value());
+    ASSERT_TRUE(std::holds_alternative<tsplib::BasicContent<int16_t>>(content));
+
+    const auto& narrow = std::get<tsplib::BasicContent<int16_t>>(content);
+    EXPECT_EQ(narrow.metaData.name, "br17");
+    EXPECT_EQ(narrow.graph.getOrder(), 17);
+    EXPECT_EQ(narrow.graph.getWeight({2, 3}).value(), 72);
+
+    const auto wide = tsplib::narrowContent(tsplib::getTspContent("DIMENSION: 2\n"
+                                                                   "EDGE_WEIGHT_TYPE: EXPLICIT\n"
+                                                                   "EDGE_WEIGHT_FORMAT: FULL_MATRIX\n"
+                                                                   "EDGE_WEIGHT_SECTION\n"
+                                                                   "0 40000\n"
+                                                                   "1 0\n"
+                                                                   "EOF\n").value());
+    ASSERT_TRUE(std::holds_alternative<tsplib::Content>(wide));
+    EXPECT_EQ(std::get<tsplib::Content>(wide).graph.getWeight({0, 1}).value(), 40000);
+}
+
+TEST(ReaderTest, NarrowestWeightTypeWhileParsing)
+{
+    const auto narrow = tsplib::getNarrowestTspContent(instance);
+    ASSERT_TRUE(narrow.has_value());
+    ASSERT_TRUE(std::holds_alternative<tsplib::BasicContent<int16_t>>(narrow.value()));
+    EXPECT_EQ(std::get<tsplib::BasicContent<int16_t>>(narrow.value()).graph.getWeight({2, 3}).value(), 72);
+
+    // The diagonal is not a part of the graph, so it does not have to fit
+    const auto diagonal = tsplib::getNarrowestTspContent("TYPE: ATSP\n"
+                                                         "DIMENSION: 2\n"
+                                                         "EDGE_WEIGHT_TYPE: EXPLICIT\n"
+                                                         "EDGE_WEIGHT_FORMAT: FULL_MATRIX\n"
+                                                         "EDGE_WEIGHT_SECTION\n"
+                                                         "100000000 5\n"
+                                                         "7 100000000\n"
+                                                         "EOF\n");
+    ASSERT_TRUE(diagonal.has_value());
+    ASSERT_TRUE(std::holds_alternative<tsplib::BasicContent<int16_t>>(diagonal.value()));
+    EXPECT_EQ(std::get<tsplib::BasicContent<int16_t>>(diagonal.value()).graph.getSize(), 2);
+
+    const auto wide = tsplib::getNarrowestTspContent("TYPE: TSP\n"
+                                                     "DIMENSION: 3\n"
+                                                     "EDGE_WEIGHT_TYPE: EXPLICIT\n"
+                                                     "EDGE_WEIGHT_FORMAT: LOWER_DIAG_ROW\n"
+                                                     "EDGE_WEIGHT_SECTION\n"
+                                                     "0\n"
+                                                     "40000 0\n"
+                                                     "1 2 0\n"
+                                                     "EOF\n");
+    ASSERT_TRUE(wide.has_value());
+    ASSERT_TRUE(std::holds_alternative<tsplib::Content>(wide.value()));
+    EXPECT_EQ(std::get<tsplib::Content>(wide.value()).graph.getWeight({1, 0}).value(), 40000);
+}
+
+TEST(ReaderTest, ForcedWeightType)
+{
+    const auto real = tsplib::getTspContentAs<float>(instance);
+    ASSERT_TRUE(real.has_value());
+    EXPECT_EQ(real->graph.getWeight({2, 3}).value(), 72.0f);
+    EXPECT_EQ(real->graph.getSize(), tsplib::getTspContent(instance)->graph.getSize());
+
+    EXPECT_FALSE(tsplib::getTspContentAs<int16_t>("DIMENSION: 2\n"
+                                                  "EDGE_WEIGHT_TYPE: EXPLICIT\n"
+                                                  "EDGE_WEIGHT_FORMAT: FULL_MATRIX\n"
+                                                  "EDGE_WEIGHT_SECTION\n"
+                                                  "0 40000\n"
+                                                  "1 0\n"
+                                                  "EOF\n").has_value());
+
+    const auto fractional = tsplib::getTspContentAs<float>("NAME: fractional\n"
+                                                           "TYPE: TSP\n"
+                                                           "DIMENSION: 3\n"
+                                                           "EDGE_WEIGHT_TYPE: EXPLICIT\n"
+                                                           "EDGE_WEIGHT_FORMAT: UPPER_ROW\n"
+                                                           "EDGE_WEIGHT_SECTION\n"
+                                                           "1.5 2.25\n"
+                                                           "0.125\n"
+                                                           "EOF\n");
+    ASSERT_TRUE(fractional.has_value());
+    EXPECT_EQ(fractional->metaData.name, "fractional");
+    EXPECT_EQ(fractional->graph.getWeight({1, 0}).value(), 1.5f);
+    EXPECT_EQ(fractional->graph.getWeight({0, 2}).value(), 2.25f);
+    EXPECT_EQ(fractional->graph.getWeight({2, 1}).value(), 0.125f);
+}
+
+TEST(ReaderTest, ForcedWeightTypeOfEdgeData)
+{
+    const auto input = std::string {"NAME: edges\n"
+                                     "TYPE: TSP\n"
+                                     "DIMENSION: 3\n"
+                                     "EDGE_WEIGHT_TYPE: EUC_2D\n"
+                                     "EDGE_DATA_FORMAT: EDGE_LIST\n"
+                                     "NODE_COORD_SECTION\n"
+                                     "1 0 0\n"
+                                     "2 3 4\n"
+                                     "3 6 8\n"
+                                     "EDGE_DATA_SECTION\n"
+                                     "1 2\n"
+                                     "2 3\n"
+                                     "-1\n"
+                                     "EOF\n"};
+
+    const auto expected = tsplib::getTspContent(input);
+    const auto narrow = tsplib::getTspContentAs<int16_t>(input);
+
+    ASSERT_TRUE(expected.has_value());
+    ASSERT_TRUE(narrow.has_value());
+    EXPECT_EQ(narrow->graph.getSize(), expected->graph.getSize());
+    EXPECT_EQ(narrow->graph.getWeight({0, 1}).value(), expected->graph.getWeight({0, 1}).value());
+    EXPECT_TRUE(narrow->coordinates.has_value());
+}
+
+TEST(ReaderTest, TriangularFormatIsPacked)
+{
+    const auto content = tsplib::getTspContent("TYPE: TSP\n"
+                                               "DIMENSION: 4\n"
+                                               "EDGE_WEIGHT_TYPE: EXPLICIT\n"
+                                               "EDGE_WEIGHT_FORMAT: UPPER_ROW\n"
+                                               "EDGE_WEIGHT_SECTION\n"
+                                               "1 2 3\n"
+                                               "4 5\n"
+                                               "6\n"
+                                               "EOF\n");
+
+    ASSERT_TRUE(content.has_value());
+    EXPECT_EQ(content->graph.getRepresentation(), tsplib::Graph::Representation::PACKED_SYMMETRIC);
+    EXPECT_EQ(content->graph.getSize(), 12);
+    EXPECT_EQ(content->graph.getWeight({0, 3}).value(), 3);
+    EXPECT_EQ(content->graph.getWeight({3, 1}).value(), 5);
+    EXPECT_EQ(content->graph.getWeight({2, 3}).value(), 6);
+}
+
+TEST(ReaderTest, SymmetricFullMatrixIsPackedOnlyForTsp)
+{
+    const auto matrix = std::string {"DIMENSION: 3\n"
+                                     "EDGE_WEIGHT_TYPE: EXPLICIT\n"
+                                     "EDGE_WEIGHT_FORMAT: FULL_MATRIX\n"
+                                     "EDGE_WEIGHT_SECTION\n"
+                                     "0 1 2\n"
+                                     "1 0 3\n"
+                                     "2 3 0\n"
+                                     "EOF\n"};
+
+    const auto tsp = tsplib::getTspContent("TYPE: TSP\n" + matrix);
+    ASSERT_TRUE(tsp.has_value());
+    EXPECT_EQ(tsp->graph.getRepresentation(), tsplib::Graph::Representation::PACKED_SYMMETRIC);
+
+    auto atsp = tsplib::getTspContent("TYPE: ATSP\n" + matrix);
+    ASSERT_TRUE(atsp.has_value());
+    EXPECT_EQ(atsp->graph.getRepresentation(), tsplib::Graph::Representation::DENSE_MATRIX);
+
+    EXPECT_TRUE(atsp->graph.setWeight({0, 1}, 100));
+    EXPECT_EQ(atsp->graph.getWeight({1, 0}).value(), 1);
+    EXPECT_TRUE(atsp->graph.removeEdge({2, 0}));
+    EXPECT_EQ(atsp->graph.getWeight({0, 2}).value(), 2);
+}
+
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+
+#include "parsers/StreamParser.h"
+
+namespace
+{
+
+constexpr auto instance = "NAME:  br17\n"
+                          "TYPE: ATSP\n"
+                          "COMMENT: 17 city problem (Repetto)\n"
+                          "DIMENSION:  17\n"
+                          "EDGE_WEIGHT_TYPE: EXPLICIT\n"
+                          "EDGE_WEIGHT_FORMAT: FULL_MATRIX\n"
+                          "UNKNOWN_TAG1: aaa\n"
+                          "UNKNOWN_TAG2\n"
+                          "EDGE_WEIGHT_SECTION:\n"
+                          " 9999    3    5   48   48    8    8    5    5    3    3    0    3    5    8    8\n"
+                          "    5\n"
+                          "    3 9999    3   48   48    8    8    5    5    0    0    3    0    3    8    8\n"
+                          "    5\n"
+                          "    5    3 9999   72   72   48   48   24   24    3    3    5    3    0   48   48\n"
+                          "   24\n"
+                          "   48   48   74 9999    0    6    6   12   12   48   48   48   48   74    6    6\n"
+                          "   12\n"
+                          "   48   48   74    0 9999    6    6   12   12   48   48   48   48   74    6    6\n"
+                          "   12\n"
+                          "    8    8   50    6    6 9999    0    8    8    8    8    8    8   50    0    0\n"
+                          "    8\n"
+                          "    8    8   50    6    6    0 9999    8    8    8    8    8    8   50    0    0\n"
+                          "    8\n"
+                          "    5    5   26   12   12    8    8 9999    0    5    5    5    5   26    8    8\n"
+                          "    0\n"
+                          "    5    5   26   12   12    8    8    0 9999    5    5    5    5   26    8    8\n"
+                          "    0\n"
+                          "    3    0    3   48   48    8    8    5    5 9999    0    3    0    3    8    8\n"
+                          "    5\n"
+                          "    3    0    3   48   48    8    8    5    5    0 9999    3    0    3    8    8\n"
+                          "    5\n"
+                          "    0    3    5   48   48    8    8    5    5    3    3 9999    3    5    8    8\n"
+                          "    5\n"
+                          "    3    0    3   48   48    8    8    5    5    0    0    3 9999    3    8    8\n"
+                          "    5\n"
+                          "    5    3    0   72   72   48   48   24   24    3    3    5    3 9999   48   48\n"
+                          "   24\n"
+                          "    8    8   50    6    6    0    0    8    8    8    8    8    8   50 9999    0\n"
+                          "    8\n"
+                          "    8    8   50    6    6    0    0    8    8    8    8    8    8   50    0 9999\n"
+                          "    8\n"
+                          "    5    5   26   12   12    8    8    0    0    5    5    5    5   26    8    8\n"
+                          " 9999\n"
+                          "EOF";
+
+constexpr auto edgeDataInstance = "NAME : edges\r\n"
+                                  "TYPE : HCP\r\n"
+                                  "DIMENSION : 4\r\n"
+                                  "EDGE_WEIGHT_TYPE : EUC_2D\r\n"
+                                  "EDGE_DATA_FORMAT : EDGE_LIST\r\n"
+                                  "NODE_COORD_SECTION\r\n"
+                                  "1 36266.6667 62550.0000\r\n"
+                                  "2 34600.0000 58633.3333\r\n"
+                                  "3 51650.0000 72300.0000\r\n"
+                                  "4 37800.0000 67683.3333\r\n"
+                                  "EDGE_DATA_SECTION\r\n"
+                                  "1 2\r\n"
+                                  "2 3\r\n"
+                                  "3 4\r\n"
+                                  "-1\r\n"
+                                  "EOF\r\n";
+
+constexpr auto nodes3dInstance = "NAME: nodes3d\n"
+                                 "NODE_COORD_SECTION\n"
+                                 "1 36266.6667 62550.0000 3.0\n"
+                                 "2 34600.0000 58633.3333 2.3\n"
+                                 "3 51650.0000 72300.0000 9.2\n"
+                                 "COMMENT: after nodes\n"
+                                 "EOF";
+
+auto expectSameConfig(const tsplib::Config& expected, const tsplib::Config& actual) -> void
+{
+    EXPECT_EQ(expected.specification.name, actual.specification.name);
+    EXPECT_EQ(expected.specification.type, actual.specification.type);
+    EXPECT_EQ(expected.specification.comment, actual.specification.comment);
+    EXPECT_EQ(expected.specification.dimension, actual.specification.dimension);
+    EXPECT_EQ(expected.specification.capacity, actual.specification.capacity);
+    EXPECT_EQ(expected.specification.edgeWeightType, actual.specification.edgeWeightType);
+    EXPECT_EQ(expected.specification.edgeWeightFormat, actual.specification.edgeWeightFormat);
+    EXPECT_EQ(expected.specification.edgeDataFormat, actual.specification.edgeDataFormat);
+    EXPECT_EQ(expected.data.edgeDataSection, actual.data.edgeDataSection);
+    EXPECT_EQ(expected.data.edgeWeightSection, actual.data.edgeWeightSection);
+
+    ASSERT_EQ(expected.data.nodeCoordSection.has_value(), actual.data.nodeCoordSection.has_value());
+    if (expected.data.nodeCoordSection)
+    {
+        ASSERT_EQ(expected.data.nodeCoordSection->index(), actual.data.nodeCoordSection->index());
+        std::visit(tsplib::match {
+            [&actual](const tsplib::Nodes2d& nodes) {
+                const auto& actualNodes = std::get<tsplib::Nodes2d>(actual.data.nodeCoordSection.value()).nodes2d;
+                ASSERT_EQ(nodes.nodes2d.size(), actualNodes.size());
+                for (auto i = size_t {}; i < actualNodes.size(); i++)
+                {
+                    EXPECT_EQ(nodes.nodes2d[i].id, actualNodes[i].id);
+                    EXPECT_EQ(nodes.nodes2d[i].x, actualNodes[i].x);
+                    EXPECT_EQ(nodes.nodes2d[i].y, actualNodes[i].y);
+                }
+            },
+            [&actual](const tsplib::Nodes3d& nodes) {
+                const auto& actualNodes = std::get<tsplib::Nodes3d>(actual.data.nodeCoordSection.value()).nodes3d;
+                ASSERT_EQ(nodes.nodes3d.size(), actualNodes.size());
+                for (auto i = size_t {}; i < actualNodes.size(); i++)
+                {
+                    EXPECT_EQ(nodes.nodes3d[i].id, actualNodes[i].id);
+                    EXPECT_EQ(nodes.nodes3d[i].x, actualNodes[i].x);
+                    EXPECT_EQ(nodes.nodes3d[i].y, actualNodes[i].y);
+                    EXPECT_EQ(nodes.nodes3d[i].z, actualNodes[i].z);
+                }
+            }
+        }, expected.data.nodeCoordSection.value());
+    }
+}
+
+auto expectSameAsTspData(std::string_view input, size_t chunkSize, size_t bufferSize) -> void
+{
+    auto parser = tsplib::TspStreamParser {bufferSize};
+
+    for (auto position = size_t {}; position < input.size(); position += chunkSize)
+    {
+        ASSERT_TRUE(parser.feed(input.substr(position, chunkSize))) << "chunk size " << chunkSize;
+    }
+
+    const auto actual = parser.finish();
+    const auto expected = tsplib::tspData(input);
+
+    ASSERT_NO_THROW(actual.value());
+    expectSameConfig(expected->first, actual.value());
+}
+
+}
+
+TEST(StreamParserTest, SameAsTspData)
+{
+    for (const auto input : {instance, edgeDataInstance, nodes3dInstance})
+    {
+        for (const auto chunkSize : {1, 2, 3, 7, 16, 61, 4096})
+        {
+            expectSameAsTspData(input, static_cast<size_t>(chunkSize), 128);
+        }
+    }
+}
+
+TEST(StreamParserTest, StopsAtUnparsableItem)
+{
+    expectSameAsTspData("NAME: a\nTYPE: XYZ\nCOMMENT: ignored\n", 3, 64);
+    expectSameAsTspData("EDGE_WEIGHT_SECTION\nEOF\nNAME: ignored\n", 3, 64);
+    expectSameAsTspData("NODE_COORD_SECTION\n1 2\nNAME: ignored\n", 3, 64);
+    expectSameAsTspData("NAME: a\nNODE_COORD_SECTION\n1 2 3\n2 3 4 5\nCOMMENT: c\n", 5, 64);
+}
+
+TEST(StreamParserTest, LineLongerThanBuffer)
+{
+    auto parser = tsplib::TspStreamParser {16};
+
+    EXPECT_FALSE(parser.feed(std::string_view {"COMMENT: this comment is too long\n"}));
+    EXPECT_FALSE(parser.finish().has_value());
+}
@@ -2,6 +2,8 @@
 
 #include "parsers/SubParsers.h"
 
+#include <string>
+
 TEST(TspReaderTest, NameParserTest)
 {
     EXPECT_EQ(std::get<tsplib::Name>(tsplib::name(" CoolName\nCOMMENT")->first).name, "CoolName");
@@ -121,6 +123,14 @@ TEST(TspReaderTest, Node3dParser)
     ASSERT_THROW(tsplib::node3d("1 345.3 -0.234\n 3\n").value(), std::bad_optional_access);
 }
 
+TEST(TspReaderTest, NodeCoordType)
+{
+    EXPECT_EQ(tsplib::nodeCoordType("\n 1 2.5 3\n2 1 1\n").value(), tsplib::NodeCoordType::_2D);
+    EXPECT_EQ(tsplib::nodeCoordType("1 2.5 3 1.0e+03\n").value(), tsplib::NodeCoordType::_3D);
+    EXPECT_FALSE(tsplib::nodeCoordType("1 2.5\n").has_value());
+    EXPECT_FALSE(tsplib::nodeCoordType("EOF\n").has_value());
+}
+
 TEST(TspReaderTest, NodeCoordSection)
 {
     using namespace std::string_view_literals;
@@ -188,6 +198,43 @@ TEST(TspReaderTest, NodeCoordSection)
                  std::bad_variant_access);
 }
 
+TEST(TspReaderTest, NodeCoordSectionOnThreads)
+{
+    // Large enough to be split into chunks of a megabyte
+    auto section = std::string {"\n"};
+    for (auto id = 1; id <= 150000; id++)
+    {
+        section += std::to_string(id) + " " + std::to_string(id % 977) + ".25 -" + std::to_string(id % 31) + "e+2\n";
+    }
+
+    const auto nodesOf = [](const auto& result) -> const std::vector<tsplib::Node2d>& {
+        return std::get<tsplib::Nodes2d>(std::get<tsplib::NodeCoordSection>(result->first).nodesCoord).nodes2d;
+    };
+
+    for (const auto& input : {section + "EOF\n", section.substr(0, section.size() / 2) + "1 2.0\n" + section})
+    {
+        const auto expected = tsplib::nodeCoordSection(input);
+        ASSERT_TRUE(expected.has_value());
+
+        for (const auto threads : {2u, 3u, 8u})
+        {
+            const auto actual = tsplib::nodeCoordSection(input, {.threads = threads});
+            ASSERT_TRUE(actual.has_value());
+
+            const auto& expectedNodes = nodesOf(expected);
+            const auto& actualNodes = nodesOf(actual);
+            ASSERT_EQ(actualNodes.size(), expectedNodes.size()) << threads;
+            for (auto i = size_t {}; i < expectedNodes.size(); i++)
+            {
+                ASSERT_EQ(actualNodes[i].id, expectedNodes[i].id);
+                ASSERT_EQ(actualNodes[i].x, expectedNodes[i].x);
+                ASSERT_EQ(actualNodes[i].y, expectedNodes[i].y);
+            }
+            EXPECT_EQ(actual->second.data(), expected->second.data());
+        }
+    }
+}
+
 TEST(TspReaderTest, edgeDataSectionParser)
 {
     using namespace std::string_view_literals;
@@ -300,4 +347,52 @@ TEST(TspReaderTest, tspDataParser)
     EXPECT_EQ(edgeWeightSection.size(), 17 * 17);
     EXPECT_EQ(edgeWeightSection.front(), 9999);
     EXPECT_EQ(edgeWeightSection.back(), 9999);
-}
\ No newline at end of file
+}
+
+TEST(TspReaderTest, specificationIndex)
+{
+    using namespace std::string_view_literals;
+    static constexpr auto instance = "NAME: small\n"
+                                     "TYPE: TSP\n"
+                                     "DIMENSION: 3\n"
+                                     "EDGE_WEIGHT_TYPE: EXPLICIT\n"
+                                     "EDGE_WEIGHT_FORMAT: FULL_MATRIX\n"
+                                     "EDGE_WEIGHT_SECTION\n"
+                                     " 0 1 2\n"
+                                     " 1 0 3\n"
+                                     " 2 3 0\n"
+                                     "DISPLAY_DATA_TYPE: NO_DISPLAY\n"
+                                     "EOF"sv;
+
+    const auto index = tsplib::specificationIndex(instance);
+
+    ASSERT_TRUE(index.has_value());
+    ASSERT_NO_THROW(index->specification.name.value());
+    EXPECT_EQ(index->specification.name.value(), "small");
+    EXPECT_EQ(index->specification.dimension.value(), 3);
+    EXPECT_EQ(index->specification.edgeWeightFormat.value(), tsplib::EdgeWeightFormat::FULL_MATRIX);
+    EXPECT_EQ(index->edgeWeightTypeKeyword.value(), "EXPLICIT");
+
+    ASSERT_EQ(index->sections.size(), 1);
+    EXPECT_EQ(index->sections.front().tag, "EDGE_WEIGHT_SECTION");
+    EXPECT_EQ(instance.substr(index->sections.front().offset, 19), "EDGE_WEIGHT_SECTION");
+
+    const auto section = tsplib::tspItem(instance.substr(index->sections.front().offset));
+    ASSERT_NO_THROW(section.value());
+    EXPECT_EQ(std::get<tsplib::EdgeWeightSection>(section->first).weights.size(), 9);
+
+    EXPECT_FALSE(tsplib::specificationIndex("NAME: small\nDIMENSION: three\nEOF").has_value());
+}
+
+
+TEST(TspReaderTest, TagParser)
+{
+    const auto result = tsplib::tag("EDGE_WEIGHT_TYPE : EUC_2D\n");
+
+    ASSERT_NO_THROW(result.value());
+    EXPECT_EQ(result->first, "EDGE_WEIGHT_TYPE");
+    EXPECT_EQ(result->second, " EUC_2D\n");
+
+    EXPECT_EQ(tsplib::tag("EDGE_WEIGHT_SECTION\n 1 2")->first, "EDGE_WEIGHT_SECTION");
+    EXPECT_FALSE(tsplib::type(" TSPX\n").has_value());
+}
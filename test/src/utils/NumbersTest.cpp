@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+
+#include "utils/Numbers.h"
+
+#include <random>
+
+TEST(NumbersTest, StringToNumber)
+{
+    EXPECT_EQ(tsplib::utils::stringToNumber<int32_t>(std::string_view {"-123 4"}).value(), -123);
+    EXPECT_FALSE(tsplib::utils::stringToNumber<int8_t>(std::string_view {"128"}).has_value());
+
+    EXPECT_DOUBLE_EQ(tsplib::utils::stringToNumber<double>(std::string_view {"36266.6667"}).value(), 36266.6667);
+    EXPECT_DOUBLE_EQ(tsplib::utils::stringToNumber<double>(std::string_view {"-1.5e+06"}).value(), -1.5e6);
+    EXPECT_FLOAT_EQ(tsplib::utils::stringToNumber<float>(std::string_view {".25"}).value(), .25f);
+    EXPECT_FALSE(tsplib::utils::stringToNumber<double>(std::string_view {"x1"}).has_value());
+    EXPECT_FALSE(tsplib::utils::stringToNumber<double>(std::string_view {"1e999"}).has_value());
+}
+
+TEST(NumbersTest, FastStringToDouble)
+{
+    EXPECT_EQ(tsplib::utils::detail::fastStringToDouble("62550.0000").value(), 62550.0);
+    EXPECT_EQ(tsplib::utils::detail::fastStringToDouble("-0.001").value(), -0.001);
+    EXPECT_EQ(tsplib::utils::detail::fastStringToDouble("12e3").value(), 12e3);
+    EXPECT_EQ(tsplib::utils::detail::fastStringToDouble("0.000000000000000000000000001").has_value(), false);
+    EXPECT_EQ(tsplib::utils::detail::fastStringToDouble("12345678901234567890").has_value(), false);
+    EXPECT_EQ(tsplib::utils::detail::fastStringToDouble("1e23").has_value(), false);
+    EXPECT_EQ(tsplib::utils::detail::fastStringToDouble(".").has_value(), false);
+
+    auto generator = std::mt19937 {42};
+    auto significands = std::uniform_int_distribution<uint64_t> {0, uint64_t {1} << 53};
+    auto exponents = std::uniform_int_distribution<int32_t> {-22, 22};
+
+    for (auto i = 0; i < 10000; i++)
+    {
+        const auto number = std::to_string(significands(generator)) + "e" + std::to_string(exponents(generator));
+        const auto fast = tsplib::utils::detail::fastStringToDouble(number);
+
+        // Whenever the fast path answers, it has to be as correctly rounded as the C library
+        if (fast)
+        {
+            EXPECT_EQ(fast.value(), tsplib::utils::detail::strtoNumber<double>(number).value()) << number;
+        }
+    }
+}